@@ -41,11 +41,11 @@ AC_REQUIRE([MPFR_CHECK_LIBM])
 AC_REQUIRE([MPFR_CHECK_LIBQUADMATH])
 AC_REQUIRE([AC_CANONICAL_HOST])
 
-dnl Features for the MPFR shared cache. This needs to be done
-dnl quite early since this may change CC, CFLAGS and LIBS, which
-dnl may affect the other tests.
+dnl Features for the MPFR shared cache and the parallel mode. This needs
+dnl to be done quite early since this may change CC, CFLAGS and LIBS,
+dnl which may affect the other tests.
 
-if test "$enable_shared_cache" = yes; then
+if test "$enable_shared_cache" = yes || test "$enable_parallel" = yes; then
 
 dnl Prefer ISO C11 threads (as in mpfr-thread.h).
   MPFR_CHECK_C11_THREAD()
@@ -93,19 +93,19 @@ pthread_rwlock_t lock; (void) lock;
     fi
   fi
 
-  AC_MSG_CHECKING(if shared cache can be supported)
+  AC_MSG_CHECKING(if threads can be supported)
   if test "$mpfr_c11_thread_ok" = yes; then
     AC_MSG_RESULT([yes, with ISO C11 threads])
   elif test "$mpfr_pthread_ok" = yes; then
     AC_MSG_RESULT([yes, with pthread])
   else
     AC_MSG_RESULT(no)
-    AC_MSG_ERROR([shared cache needs C11 threads or pthread support])
+    AC_MSG_ERROR([shared cache and parallel mode need C11 threads or pthread support])
   fi
 
 fi
 
-dnl End of features for the MPFR shared cache.
+dnl End of features for the MPFR shared cache and the parallel mode.
 
 AC_CHECK_HEADER([limits.h],, AC_MSG_ERROR([limits.h not found]))
 AC_CHECK_HEADER([float.h],,  AC_MSG_ERROR([float.h not found]))
@@ -878,6 +878,27 @@ return v.n != 0x4000 || d != 2.0;
        AC_DEFINE([MPFR_WANT_BFLOAT16],1,[Build __bf16 functions])],
       [AC_MSG_RESULT(no)])
 
+dnl Check if the functions can be compiled for the x86-64 micro-architecture
+dnl levels with the target_clones attribute (GCC 11+). This also needs the
+dnl ifunc support from the linker and the C library, hence AC_LINK_IFELSE.
+if test "$enable_fmv" = yes; then
+   AC_MSG_CHECKING(if target_clones with x86-64 levels is supported)
+   AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+static __attribute__ ((target_clones ("arch=x86-64-v4", "arch=x86-64-v3",
+                                      "arch=x86-64-v2", "default")))
+int foo (int x) { return x + 1; }
+]], [[
+volatile int x = 0;
+return foo (x) != 1;
+]])],
+      [AC_MSG_RESULT(yes)
+       AC_DEFINE([MPFR_WANT_FMV],1,[Use function multiversioning])],
+      [AC_MSG_RESULT(no)
+       AC_MSG_ERROR(
+[compiler doesn't support target_clones with the x86-64 levels.
+Please use another compiler or build MPFR without --enable-fmv.])])
+fi
+
 dnl Check if Static Assertions are supported.
 AC_MSG_CHECKING(for Static Assertion support)
 saved_CPPFLAGS="$CPPFLAGS"
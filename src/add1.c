@@ -89,6 +89,20 @@ mpfr_add1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       MPN_COPY(cp, ap, cn);
     }
 
+  /* Skip the trailing zero limbs of b and c, which do not change the sum;
+     only bp, bn, cp and cn are used below. The loops end since the most
+     significant limbs are nonzero. */
+  while (*bp == 0)
+    {
+      bp++;
+      bn--;
+    }
+  while (*cp == 0)
+    {
+      cp++;
+      cn--;
+    }
+
   MPFR_SET_SAME_SIGN(a, b);
   MPFR_UPDATE2_RND_MODE (rnd_mode, MPFR_SIGN (b));
   /* now rnd_mode is either MPFR_RNDN, MPFR_RNDZ, MPFR_RNDA or MPFR_RNDF. */
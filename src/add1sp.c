@@ -126,7 +126,7 @@ int mpfr_add1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 #else
 
 /* same as mpfr_add1sp, but for p < GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_add1sp1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
               mpfr_prec_t p)
 {
@@ -254,7 +254,7 @@ mpfr_add1sp1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
 #endif /* MPFR_WANT_PROVEN_CODE */
 
 /* same as mpfr_add1sp, but for p = GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_add1sp1n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mpfr_exp_t bx = MPFR_GET_EXP (b);
@@ -358,7 +358,7 @@ mpfr_add1sp1n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 }
 
 /* same as mpfr_add1sp, but for GMP_NUMB_BITS < p < 2*GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_add1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
               mpfr_prec_t p)
 {
@@ -480,7 +480,7 @@ mpfr_add1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
 }
 
 /* same as mpfr_add1sp, but for p = 2*GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_add1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mpfr_exp_t bx = MPFR_GET_EXP (b);
@@ -611,7 +611,7 @@ mpfr_add1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 }
 
 /* same as mpfr_add1sp, but for 2*GMP_NUMB_BITS < p < 3*GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
               mpfr_prec_t p)
 {
@@ -1093,3 +1093,74 @@ mpfr_add1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 
   MPFR_RET (inexact * MPFR_INT_SIGN (a));
 }
+
+/* Set a[i] to b[i] + c[i] for 0 <= i < n, and t[i] to the corresponding
+   ternary value (if t is not a null pointer). The choice of the kernel
+   is done once from the precision of a[0]; the elements whose precisions
+   differ from it, or with a singular input, are given to mpfr_add, and
+   those whose inputs have different signs to mpfr_sub1sp.
+   Return 0 iff all the results are exact. */
+int
+mpfr_add_vec (const mpfr_ptr *a, const mpfr_ptr *b, const mpfr_ptr *c,
+              unsigned long n, mpfr_rnd_t rnd_mode, int *t)
+{
+  unsigned long i;
+  int inex, res = 0;
+
+#if !defined(MPFR_GENERIC_ABI)
+#define ADD_VEC_LOOP(KERNEL)                                            \
+  for (i = 0; i < n; i++)                                               \
+    {                                                                   \
+      if (MPFR_UNLIKELY (MPFR_PREC (a[i]) != p || MPFR_PREC (b[i]) != p \
+                         || MPFR_PREC (c[i]) != p                       \
+                         || MPFR_ARE_SINGULAR_OR_UBF (b[i], c[i])))     \
+        inex = mpfr_add (a[i], b[i], c[i], rnd_mode);                   \
+      else if (MPFR_UNLIKELY (MPFR_SIGN (b[i]) != MPFR_SIGN (c[i])))    \
+        inex = mpfr_sub1sp (a[i], b[i], c[i], rnd_mode);                \
+      else                                                              \
+        {                                                               \
+          MPFR_SET_SAME_SIGN (a[i], b[i]);                              \
+          inex = KERNEL;                                                \
+        }                                                               \
+      res |= inex;                                                      \
+      if (t != NULL)                                                    \
+        t[i] = inex;                                                    \
+    }                                                                   \
+  return res
+
+  if (n != 0)
+    {
+      mpfr_prec_t p = MPFR_GET_PREC (a[0]);
+
+      if (p < GMP_NUMB_BITS)
+        {
+          ADD_VEC_LOOP (mpfr_add1sp1 (a[i], b[i], c[i], rnd_mode, p));
+        }
+      if (GMP_NUMB_BITS < p && p < 2 * GMP_NUMB_BITS)
+        {
+          ADD_VEC_LOOP (mpfr_add1sp2 (a[i], b[i], c[i], rnd_mode, p));
+        }
+      if (p == GMP_NUMB_BITS)
+        {
+          ADD_VEC_LOOP (mpfr_add1sp1n (a[i], b[i], c[i], rnd_mode));
+        }
+      if (2 * GMP_NUMB_BITS < p && p < 3 * GMP_NUMB_BITS)
+        {
+          ADD_VEC_LOOP (mpfr_add1sp3 (a[i], b[i], c[i], rnd_mode, p));
+        }
+      if (p == 2 * GMP_NUMB_BITS)
+        {
+          ADD_VEC_LOOP (mpfr_add1sp2n (a[i], b[i], c[i], rnd_mode));
+        }
+    }
+#endif
+
+  for (i = 0; i < n; i++)
+    {
+      inex = mpfr_add (a[i], b[i], c[i], rnd_mode);
+      res |= inex;
+      if (t != NULL)
+        t[i] = inex;
+    }
+  return res;
+}
@@ -635,9 +635,9 @@ mpfr_ai2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd)
    * If x>0 and MPFR_AI_THRESHOLD3*x + MPFR_AI_THRESHOLD2*prec > MPFR_AI_SCALE,
    use Smith' algorithm;
    * otherwise, use the naive method.
-*/
 
-#define MPFR_AI_SCALE 1048576
+   MPFR_AI_SCALE is defined in mpfr-impl.h (it is also used by tune_run.c).
+*/
 
 int
 mpfr_ai (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd)
@@ -0,0 +1,196 @@
+/* mpfr_set_arena_size, mpfr_get_arena_size -- per-thread arena for the
+   internal temporary variables
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_ARENA_DONT_REDEFINE
+#include "mpfr-impl.h"
+
+/* The arena is a buffer of the current thread, in which the significands
+   of the internal temporary variables (mpfr_init2 within MPFR, groups and
+   MPFR_TMP_ALLOC when the stack is not used, except when it is based on
+   GMP's TMP_ALLOC, i.e. with MPFR_HAVE_GMP_IMPL) are allocated by
+   increasing addresses: a block is just obtained by incrementing the top
+   of the arena. The block at the top can be extended or given back, but
+   the other ones are really freed only when all the blocks have been
+   freed, which normally happens on return from the top-level MPFR
+   function; the whole arena is then available again. When a block does
+   not fit, it is allocated with the GMP memory functions, as if the arena
+   were disabled.
+
+   The blocks are always freed by the thread that has allocated them,
+   since the temporary variables are local to a function call. */
+
+struct mpfr_arena_s {
+  size_t size;          /* size of the arena, 0 if disabled */
+  char *base;           /* buffer, NULL if not allocated yet */
+  size_t top;           /* offset of the first free byte */
+  unsigned long live;   /* number of blocks not freed yet */
+  size_t peak;          /* maximum of top */
+  unsigned long misses; /* blocks that did not fit */
+};
+
+static MPFR_THREAD_ATTR struct mpfr_arena_s arena;
+
+/* Alignment of the blocks, which is sufficient for limbs (the first limb
+   of a significand may hold its size, see mpfr_size_limb_t). */
+#define ARENA_ALIGN 16
+#define ARENA_ROUND(n) \
+  (((n) + (ARENA_ALIGN - 1)) & ~ (size_t) (ARENA_ALIGN - 1))
+
+#define ARENA_CONTAINS(p)                                       \
+  (arena.base != NULL && (char *) (p) >= arena.base             \
+   && (char *) (p) < arena.base + arena.top)
+
+int
+mpfr_set_arena_size (size_t size)
+{
+  if (arena.live != 0)
+    return 1;  /* some blocks are still used */
+  if (arena.base != NULL && size != arena.size)
+    {
+      mpfr_free_func (arena.base, arena.size);
+      arena.base = NULL;
+    }
+  arena.size = ARENA_ROUND (size);
+  arena.top = 0;
+  return 0;
+}
+
+size_t
+mpfr_get_arena_size (void)
+{
+  return arena.size;
+}
+
+void
+mpfr_arena_stats (mpfr_memory_stats_t *s)
+{
+  s->arena_size = arena.size;
+  s->arena_peak = arena.peak;
+  s->arena_misses = arena.misses;
+}
+
+/* Free the buffer of the arena (which stays enabled, the buffer being
+   allocated again when needed), unless some blocks are still used. */
+void
+mpfr_free_arena (void)
+{
+  if (arena.base != NULL && arena.live == 0)
+    {
+      mpfr_free_func (arena.base, arena.size);
+      arena.base = NULL;
+      arena.top = 0;
+    }
+}
+
+void *
+mpfr_arena_allocate (size_t n)
+{
+  size_t m = ARENA_ROUND (n);
+
+  if (arena.size - arena.top >= m && m >= n)
+    {
+      char *p;
+
+      if (MPFR_UNLIKELY (arena.base == NULL))
+        arena.base = (char *) mpfr_allocate_func (arena.size);
+      p = arena.base + arena.top;
+      arena.top += m;
+      arena.live++;
+      if (arena.top > arena.peak)
+        arena.peak = arena.top;
+      return p;
+    }
+  if (arena.size != 0)
+    arena.misses++;
+  return mpfr_allocate_func (n);
+}
+
+void *
+mpfr_arena_reallocate (void *p, size_t old_size, size_t new_size)
+{
+  void *q;
+
+  if (! ARENA_CONTAINS (p))
+    return mpfr_reallocate_func (p, old_size, new_size);
+
+  /* If the block is at the top of the arena, extend it in place. */
+  if ((char *) p + ARENA_ROUND (old_size) == arena.base + arena.top)
+    {
+      size_t start = (char *) p - arena.base;
+      size_t m = ARENA_ROUND (new_size);
+
+      if (arena.size - start >= m && m >= new_size)
+        {
+          arena.top = start + m;
+          if (arena.top > arena.peak)
+            arena.peak = arena.top;
+          return p;
+        }
+    }
+
+  q = mpfr_arena_allocate (new_size);
+  memcpy (q, p, old_size < new_size ? old_size : new_size);
+  mpfr_arena_free (p, old_size);
+  return q;
+}
+
+void
+mpfr_arena_free (void *p, size_t n)
+{
+  if (! ARENA_CONTAINS (p))
+    {
+      mpfr_free_func (p, n);
+      return;
+    }
+
+  MPFR_ASSERTD (arena.live > 0);
+  if (--arena.live == 0)
+    arena.top = 0;
+  else if ((char *) p + ARENA_ROUND (n) == arena.base + arena.top)
+    arena.top = (char *) p - arena.base;
+}
+
+/* Same as mpfr_init2, but the significand is allocated in the arena. */
+void
+mpfr_tmp_init2 (mpfr_ptr x, mpfr_prec_t p)
+{
+  mp_size_t xsize;
+  mpfr_size_limb_t *tmp;
+
+  if (arena.size == 0)
+    {
+      mpfr_init2 (x, p);
+      return;
+    }
+
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  xsize = MPFR_PREC2LIMBS (p);
+  tmp = (mpfr_size_limb_t *) mpfr_arena_allocate (MPFR_MALLOC_SIZE (xsize));
+
+  MPFR_PREC(x) = p;
+  MPFR_EXP (x) = MPFR_EXP_INVALID;
+  MPFR_SET_POS(x);
+  MPFR_SET_MANT_PTR(x, tmp);
+  MPFR_SET_ALLOC_SIZE(x, xsize);
+  MPFR_SET_NAN(x);
+}
@@ -0,0 +1,129 @@
+/* mpfr_async_const, mpfr_async_unary, mpfr_async_binary, mpfr_async_poll,
+   mpfr_async_wait -- asynchronous computations by the worker threads
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* An asynchronous computation is a task of the parallel mode (see
+   parallel.c), which already runs the function with the exponent range
+   and the defaults of the submitting thread, and adds the flags it raises
+   to the ones of the thread joining it, i.e., calling mpfr_async_wait. */
+typedef struct
+{
+  mpfr_task_t task;
+  int n;                        /* number of inputs: 0, 1 or 2 */
+  union
+  {
+    mpfr_const_func_t f0;
+    mpfr_unary_func_t f1;
+    mpfr_binary_func_t f2;
+  } func;
+  mpfr_ptr rop;
+  mpfr_srcptr op1, op2;
+  mpfr_rnd_t rnd;
+  int inex;                     /* ternary value */
+} mpfr_async_data;
+
+static void
+async_task (void *arg)
+{
+  mpfr_async_data *d = (mpfr_async_data *) arg;
+
+  switch (d->n)
+    {
+    case 0:
+      d->inex = d->func.f0 (d->rop, d->rnd);
+      break;
+    case 1:
+      d->inex = d->func.f1 (d->rop, d->op1, d->rnd);
+      break;
+    default:
+      MPFR_ASSERTD (d->n == 2);
+      d->inex = d->func.f2 (d->rop, d->op1, d->op2, d->rnd);
+    }
+}
+
+static mpfr_async_data *
+async_new (__mpfr_async_struct *a, int n, mpfr_ptr rop, mpfr_srcptr op1,
+           mpfr_srcptr op2, mpfr_rnd_t rnd)
+{
+  mpfr_async_data *d;
+
+  d = (mpfr_async_data *) mpfr_allocate_func (sizeof (mpfr_async_data));
+  d->n = n;
+  d->rop = rop;
+  d->op1 = op1;
+  d->op2 = op2;
+  d->rnd = rnd;
+  a->_mpfr_task = d;
+  return d;
+}
+
+void
+mpfr_async_const (__mpfr_async_struct *a, mpfr_const_func_t f, mpfr_ptr rop,
+                  mpfr_rnd_t rnd)
+{
+  mpfr_async_data *d = async_new (a, 0, rop, NULL, NULL, rnd);
+
+  d->func.f0 = f;
+  mpfr_task_fork (&d->task, async_task, d);
+}
+
+void
+mpfr_async_unary (__mpfr_async_struct *a, mpfr_unary_func_t f, mpfr_ptr rop,
+                  mpfr_srcptr op, mpfr_rnd_t rnd)
+{
+  mpfr_async_data *d = async_new (a, 1, rop, op, NULL, rnd);
+
+  d->func.f1 = f;
+  mpfr_task_fork (&d->task, async_task, d);
+}
+
+void
+mpfr_async_binary (__mpfr_async_struct *a, mpfr_binary_func_t f, mpfr_ptr rop,
+                   mpfr_srcptr op1, mpfr_srcptr op2, mpfr_rnd_t rnd)
+{
+  mpfr_async_data *d = async_new (a, 2, rop, op1, op2, rnd);
+
+  d->func.f2 = f;
+  mpfr_task_fork (&d->task, async_task, d);
+}
+
+int
+mpfr_async_poll (__mpfr_async_struct *a)
+{
+  mpfr_async_data *d = (mpfr_async_data *) a->_mpfr_task;
+
+  return mpfr_task_done_p (&d->task);
+}
+
+int
+mpfr_async_wait (__mpfr_async_struct *a)
+{
+  mpfr_async_data *d = (mpfr_async_data *) a->_mpfr_task;
+  int inex;
+
+  mpfr_task_join (&d->task);
+  inex = d->inex;
+  mpfr_free_func (d, sizeof (mpfr_async_data));
+  a->_mpfr_task = NULL;
+  return inex;
+}
@@ -34,86 +34,71 @@ is_prime (unsigned long p)
   return 1;
 }
 
-/* Computes and stores B[2n]*(2n+1)! in b[n]
-   using Von Staudt–Clausen theorem, which says that the denominator of B[n]
-   divides the product of all primes p such that p-1 divides n.
-   Since B[n] = zeta(n) * 2*n!/(2pi)^n, we compute an approximation of
-   (2n+1)! * zeta(n) * 2*n!/(2pi)^n and round it to the nearest integer. */
+/* Set den to the denominator of B[n], n even, n >= 2, using Von
+   Staudt–Clausen theorem, which says that the denominator of B[n] is
+   the product of all primes p such that p-1 divides n. */
 static void
-mpfr_bernoulli_internal (mpz_t *b, unsigned long n)
+bernoulli_den (mpz_ptr den, unsigned long n)
 {
-  unsigned long p, err, zn;
-  mpz_t s, t, u, den;
-  mpz_ptr num;
-  mpfr_t y, z;
-  int ok;
-  /* Prec[n/2] is minimal precision so that result is correct for B[n] */
-  mpfr_prec_t prec;
-  mpfr_prec_t Prec[] = {0, 5, 5, 6, 6, 9, 16, 10, 19, 23, 25, 27, 35, 31,
-                        42, 51, 51, 50, 73, 60, 76, 79, 83, 87, 101, 97,
-                        108, 113, 119, 125, 149, 133, 146};
-
-  mpz_init (b[n]);
+  unsigned long p;
 
-  if (n == 0)
-    {
-      mpz_set_ui (b[0], 1);
-      return;
-    }
-
-  /* compute denominator */
-  num = b[n];
-  n = 2 * n;
-  mpz_init_set_ui (den, 6);
+  mpz_set_ui (den, 6);
   for (p = 5; p <= n+1; p += 2)
     {
       if ((n % (p-1)) == 0 && is_prime (p))
         mpz_mul_ui (den, den, p);
     }
+}
+
+/* Return the working precision for B[n], n even, n >= 2, where den is the
+   denominator of B[n]. */
+static mpfr_prec_t
+bernoulli_prec (unsigned long n, mpz_srcptr den)
+{
+  /* Prec[n/2] is minimal precision so that result is correct for B[n] */
+  static const mpfr_prec_t Prec[] = {0, 5, 5, 6, 6, 9, 16, 10, 19, 23, 25,
+                                     27, 35, 31, 42, 51, 51, 50, 73, 60, 76,
+                                     79, 83, 87, 101, 97, 108, 113, 119, 125,
+                                     149, 133, 146};
+  mpfr_prec_t prec;
+  unsigned long p;
+  mpfr_t z;
+
   if (n <= 64)
-    prec = Prec[n >> 1];
-  else
-    {
-      /* evaluate the needed precision: zeta(n)*2*den*n!/(2*pi)^n <=
-         3.3*den*(n/e/2/pi)^n*sqrt(2*pi*n) */
-      prec = __gmpfr_ceil_log2 (7.0 * (double) n); /* bound 2*pi by 7 */
-      prec = (prec + 1) >> 1; /* sqrt(2*pi*n) <= 2^prec */
-      mpfr_init2 (z, 53);
-      mpfr_set_ui_2exp (z, 251469612, -32, MPFR_RNDU); /* 1/e/2/pi <= z */
-      mpfr_mul_ui (z, z, n, MPFR_RNDU);
-      mpfr_log2 (z, z, MPFR_RNDU);
-      mpfr_mul_ui (z, z, n, MPFR_RNDU);
-      p = mpfr_get_ui (z, MPFR_RNDU); /* (n/e/2/pi)^n <= 2^p */
-      mpfr_clear (z);
-      MPFR_INC_PREC (prec, p + mpz_sizeinbase (den, 2));
-      /* the +2 term ensures no rounding failure up to n=10000 */
-      MPFR_INC_PREC (prec, __gmpfr_ceil_log2 (prec) + 2);
-    }
+    return Prec[n >> 1];
+
+  /* evaluate the needed precision: zeta(n)*2*den*n!/(2*pi)^n <=
+     3.3*den*(n/e/2/pi)^n*sqrt(2*pi*n) */
+  prec = __gmpfr_ceil_log2 (7.0 * (double) n); /* bound 2*pi by 7 */
+  prec = (prec + 1) >> 1; /* sqrt(2*pi*n) <= 2^prec */
+  mpfr_init2 (z, 53);
+  mpfr_set_ui_2exp (z, 251469612, -32, MPFR_RNDU); /* 1/e/2/pi <= z */
+  mpfr_mul_ui (z, z, n, MPFR_RNDU);
+  mpfr_log2 (z, z, MPFR_RNDU);
+  mpfr_mul_ui (z, z, n, MPFR_RNDU);
+  p = mpfr_get_ui (z, MPFR_RNDU); /* (n/e/2/pi)^n <= 2^p */
+  mpfr_clear (z);
+  MPFR_INC_PREC (prec, p + mpz_sizeinbase (den, 2));
+  /* the +2 term ensures no rounding failure up to n=10000 */
+  MPFR_INC_PREC (prec, __gmpfr_ceil_log2 (prec) + 2);
+  return prec;
+}
+
+/* Assuming that s contains sum(floor(u/q^n), q=3..p-1), where u = 2^prec
+   and floor(u/(p-1)^n) = 0, set s to an approximation of u * zeta(n). */
+static void
+bernoulli_zeta (mpz_ptr s, mpz_srcptr u, unsigned long n, unsigned long p)
+{
+  mpz_t t;
 
- try_again:
-  mpz_init (s);
   mpz_init (t);
-  mpz_init (u);
-  mpz_set_ui (u, 1);
-  mpz_mul_2exp (u, u, prec); /* u = 2^prec */
-  mpz_ui_pow_ui (t, 3, n);
-  mpz_fdiv_q (s, u, t); /* multiply all terms by 2^prec */
-  /* we compute a lower bound of the series, thus the final result cannot
-     be too large */
-  for (p = 4; mpz_cmp_ui (t, 0) > 0; p++)
-    {
-      mpz_ui_pow_ui (t, p, n);
-      mpz_fdiv_q (t, u, t);
-      /* 2^prec/p^n-1 < t <= 2^prec/p^n */
-      mpz_add (s, s, t);
-    }
-  /* sum(2^prec/q^n-1, q=3..p) < t <= sum(2^prec/q^n, q=3..p)
-     thus the error on the truncated series is at most p-2.
-     The neglected part of the series is R = sum(1/x^n, x=p+1..infinity)
-     with int(1/x^n, x=p+1..infinity) <= R <= int(1/x^n, x=p..infinity)
-     thus 1/(n-1)/(p+1)^(n-1) <= R <= 1/(n-1)/p^(n-1). The difference between
-     the lower and upper bound is bounded by p^(-n), which is bounded by
-     2^(-prec) since t=0 in the above loop */
+  /* sum(2^prec/q^n-1, q=3..p-1) < s <= sum(2^prec/q^n, q=3..p-1)
+     thus the error on the truncated series is at most p-3.
+     The neglected part of the series is R = sum(1/x^n, x=p..infinity)
+     with int(1/x^n, x=p..infinity) <= R <= int(1/x^n, x=p-1..infinity)
+     thus 1/(n-1)/p^(n-1) <= R <= 1/(n-1)/(p-1)^(n-1). The difference
+     between the lower and upper bound is bounded by (p-1)^(-n), which is
+     bounded by 2^(-prec) since floor(u/(p-1)^n) = 0 */
   mpz_ui_pow_ui (t, p, n - 1);
   mpz_mul_ui (t, t, n - 1);
   mpz_cdiv_q (t, u, t);
@@ -122,12 +107,29 @@ mpfr_bernoulli_internal (mpz_t *b, unsigned long n)
   /* add 1 which is 2^prec */
   mpz_add (s, s, u);
   /* add 1/2^n which is 2^(prec-n) */
-  mpz_cdiv_q_2exp (u, u, n);
-  mpz_add (s, s, u);
+  mpz_cdiv_q_2exp (t, u, n);
+  mpz_add (s, s, t);
   /* now 2^prec * zeta(n) - p < s <= 2^prec * zeta(n) */
+  mpz_clear (t);
+}
+
+/* Assuming 2^prec * zeta(n) - p < s <= 2^prec * zeta(n), and that fac = n!
+   and den is the denominator of B[n], compute num = B[n]*(n+1)! (s is
+   destroyed). Since B[n] = zeta(n) * 2*n!/(2pi)^n, we compute an
+   approximation of (n+1)! * zeta(n) * 2*n!/(2pi)^n and round it to the
+   nearest integer. Return 0 if the precision was not sufficient to
+   guarantee the result, a non-zero value otherwise. */
+static int
+bernoulli_round (mpz_ptr num, mpz_ptr s, mpz_srcptr fac, mpz_srcptr den,
+                 unsigned long n, unsigned long p, mpfr_prec_t prec)
+{
+  unsigned long err, zn;
+  mpz_t t;
+  mpfr_t y, z;
+  int ok;
+
   /* multiply by n! */
-  mpz_fac_ui (t, n);
-  mpz_mul (s, s, t);
+  mpz_mul (s, s, fac);
   /* multiply by 2*den */
   mpz_mul (s, s, den);
   mpz_mul_2exp (s, s, 1);
@@ -181,12 +183,61 @@ mpfr_bernoulli_internal (mpz_t *b, unsigned long n)
     mpz_neg (num, num);
 
   /* multiply by (n+1)! */
-  mpz_mul_ui (t, t, n + 1);
-  mpz_divexact (t, t, den); /* t was still n! */
+  mpz_init (t);
+  mpz_mul_ui (t, fac, n + 1);
+  mpz_divexact (t, t, den);
   mpz_mul (num, num, t);
 
   mpfr_clear (y);
   mpfr_clear (z);
+  mpz_clear (t);
+  return ok;
+}
+
+/* Computes and stores B[2n]*(2n+1)! in b, which is not initialized. */
+static void
+mpfr_bernoulli_internal (mpz_ptr b, unsigned long n)
+{
+  unsigned long p;
+  mpz_t s, t, u, den, fac;
+  int ok;
+  mpfr_prec_t prec;
+
+  mpz_init (b);
+
+  if (n == 0)
+    {
+      mpz_set_ui (b, 1);
+      return;
+    }
+
+  n = 2 * n;
+  mpz_init (den);
+  bernoulli_den (den, n);
+  prec = bernoulli_prec (n, den);
+  mpz_init (fac);
+  mpz_fac_ui (fac, n);
+
+ try_again:
+  mpz_init (s);
+  mpz_init (t);
+  mpz_init (u);
+  mpz_set_ui (u, 1);
+  mpz_mul_2exp (u, u, prec); /* u = 2^prec */
+  mpz_ui_pow_ui (t, 3, n);
+  mpz_fdiv_q (s, u, t); /* multiply all terms by 2^prec */
+  /* we compute a lower bound of the series, thus the final result cannot
+     be too large */
+  for (p = 4; mpz_cmp_ui (t, 0) > 0; p++)
+    {
+      mpz_ui_pow_ui (t, p, n);
+      mpz_fdiv_q (t, u, t);
+      /* 2^prec/p^n-1 < t <= 2^prec/p^n */
+      mpz_add (s, s, t);
+    }
+  bernoulli_zeta (s, u, n, p);
+  ok = bernoulli_round (b, s, fac, den, n, p, prec);
+
   mpz_clear (s);
   mpz_clear (t);
   mpz_clear (u);
@@ -198,57 +249,245 @@ mpfr_bernoulli_internal (mpz_t *b, unsigned long n)
     }
 
   mpz_clear (den);
+  mpz_clear (fac);
 }
 
-static MPFR_THREAD_ATTR mpz_t *bernoulli_table = NULL;
-static MPFR_THREAD_ATTR unsigned long bernoulli_size = 0;
-static MPFR_THREAD_ATTR unsigned long bernoulli_alloc = 0;
+/* The table of the B[2n]*(2n+1)!, 0 <= n < size. In order not to move the
+   entries when the table grows (the pointers returned by
+   mpfr_bernoulli_cache must remain valid, possibly in other threads), it
+   consists of blocks, block k having BERNOULLI_BLOCK0 << k entries.
+   With the shared cache, the table is global to all threads. The entries
+   are only read once they are published by the (atomic) update of size,
+   and a lock is needed only to compute new entries. */
+#define BERNOULLI_BLOCK0 16
+#define BERNOULLI_NBLOCKS (sizeof (unsigned long) * CHAR_BIT - 4)
 
-mpz_srcptr
-mpfr_bernoulli_cache (unsigned long n)
+struct bernoulli_table_s {
+  mpz_t *block[BERNOULLI_NBLOCKS];
+  unsigned long size;
+  size_t bytes;  /* size of the table, updated under the lock */
+  MPFR_DEFERRED_INIT_SLAVE_DECL()
+  MPFR_LOCK_DECL(lock)
+};
+
+/* As for the caches of the constants (MPFR_DECL_INIT_CACHE), the table
+   must be declared before the functions initializing its lock. */
+extern MPFR_CACHE_ATTR struct bernoulli_table_s __gmpfr_bernoulli_table;
+MPFR_DEFERRED_INIT_MASTER_DECL(bernoulli,
+  MPFR_LOCK_INIT (__gmpfr_bernoulli_table.lock),
+  MPFR_LOCK_CLEAR (__gmpfr_bernoulli_table.lock))
+MPFR_CACHE_ATTR struct bernoulli_table_s __gmpfr_bernoulli_table = {
+  { NULL }, 0, 0
+  MPFR_DEFERRED_INIT_SLAVE_VALUE(bernoulli)
+};
+
+/* Return the number of entries of the table. */
+static unsigned long
+bernoulli_size (void)
 {
-  unsigned long i;
+#if defined(MPFR_NEED_THREAD_LOCK) && !defined(MPFR_HAVE_ATOMIC)
+  unsigned long size;
+
+  MPFR_LOCK_READ (__gmpfr_bernoulli_table.lock);
+  size = __gmpfr_bernoulli_table.size;
+  MPFR_UNLOCK_READ (__gmpfr_bernoulli_table.lock);
+  return size;
+#else
+  return MPFR_ATOMIC_LOAD (__gmpfr_bernoulli_table.size);
+#endif
+}
 
-  if (n >= bernoulli_size)
+/* Return entry n of the table, allocating its block if need be (only
+   when the write lock is held). */
+static mpz_ptr
+bernoulli_entry (unsigned long n)
+{
+  unsigned long k, size;
+
+  for (k = 0, size = BERNOULLI_BLOCK0; n >= size; k++, size <<= 1)
+    n -= size;
+  MPFR_ASSERTN (k < BERNOULLI_NBLOCKS);
+  if (MPFR_UNLIKELY (__gmpfr_bernoulli_table.block[k] == NULL))
+    __gmpfr_bernoulli_table.block[k] = (mpz_t *)
+      mpfr_allocate_func (size * sizeof (mpz_t));
+  return __gmpfr_bernoulli_table.block[k][n];
+}
+
+/* Computes and stores B[2n]*(2n+1)! in the table for n0 <= n <= n1, with
+   1 <= n0 < n1. This is done like mpfr_bernoulli_internal, but with the
+   same precision prec for all n, so that the terms of the series can be
+   shared: for each q, floor(2^prec/q^(2n0)) is computed as a division of
+   large integers, then floor(2^prec/q^(2n)) for the next values of n is
+   obtained by divisions by q^2, since floor(floor(a/b)/c) = floor(a/(bc)).
+   Thus the values of s are the same as those that mpfr_bernoulli_internal
+   would compute in precision prec. The factorials are also computed from
+   each other. */
+static void
+bernoulli_batch (unsigned long n0, unsigned long n1)
+{
+  unsigned long m = n1 - n0 + 1, k, q, *p;
+  mpz_t *s, *den, u, t, fac;
+  mpfr_prec_t prec = 0;
+
+  MPFR_ASSERTD (1 <= n0 && n0 < n1);
+  s = (mpz_t *) mpfr_allocate_func (m * sizeof (mpz_t));
+  den = (mpz_t *) mpfr_allocate_func (m * sizeof (mpz_t));
+  p = (unsigned long *) mpfr_allocate_func (m * sizeof (unsigned long));
+  for (k = 0; k < m; k++)
     {
-      if (bernoulli_alloc == 0)
+      mpfr_prec_t pk;
+
+      mpz_init (s[k]);
+      mpz_init (den[k]);
+      bernoulli_den (den[k], 2 * (n0 + k));
+      pk = bernoulli_prec (2 * (n0 + k), den[k]);
+      if (pk > prec)
+        prec = pk;
+      p[k] = 0;
+    }
+
+  mpz_init (t);
+  mpz_init (u);
+  mpz_set_ui (u, 1);
+  mpz_mul_2exp (u, u, prec); /* u = 2^prec */
+  /* Since floor(2^prec/q^(2n)) decreases with n, the series for n0 is the
+     last one to end. */
+  for (q = 3; p[0] == 0; q++)
+    {
+      mpz_ui_pow_ui (t, q, 2 * n0);
+      mpz_fdiv_q (t, u, t);
+      for (k = 0; k < m && p[k] == 0; k++)
         {
-          bernoulli_alloc = MAX(16, n + n/4);
-          bernoulli_table = (mpz_t *)
-            mpfr_allocate_func (bernoulli_alloc * sizeof (mpz_t));
-          bernoulli_size  = 0;
+          mpz_add (s[k], s[k], t);
+          if (mpz_sgn (t) == 0)
+            p[k] = q + 1;  /* as the final value of p in the loop of
+                              mpfr_bernoulli_internal */
+          else if (q <= 65535)
+            mpz_fdiv_q_ui (t, t, q * q);
+          else
+            {
+              mpz_fdiv_q_ui (t, t, q);
+              mpz_fdiv_q_ui (t, t, q);
+            }
         }
-      else if (n >= bernoulli_alloc)
+    }
+
+  mpz_init (fac);
+  mpz_fac_ui (fac, 2 * n0);
+  for (k = 0; k < m; k++)
+    {
+      unsigned long n = 2 * (n0 + k);
+      mpz_ptr b = bernoulli_entry (n0 + k);
+
+      bernoulli_zeta (s[k], u, n, p[k]);
+      mpz_init (b);
+      if (MPFR_UNLIKELY (! bernoulli_round (b, s[k], fac, den[k], n, p[k],
+                                            prec)))
         {
-          bernoulli_table = (mpz_t *) mpfr_reallocate_func
-            (bernoulli_table, bernoulli_alloc * sizeof (mpz_t),
-             (n + n/4) * sizeof (mpz_t));
-          bernoulli_alloc = n + n/4;
+          /* should not happen, since prec is at least the precision
+             chosen by mpfr_bernoulli_internal, which increases it */
+          mpz_clear (b);
+          mpfr_bernoulli_internal (b, n0 + k);
         }
-      MPFR_ASSERTD (bernoulli_alloc > n);
-      MPFR_ASSERTD (bernoulli_size >= 0);
-      for (i = bernoulli_size; i <= n; i++)
-        mpfr_bernoulli_internal (bernoulli_table, i);
-      bernoulli_size = n+1;
+      mpz_mul_ui (fac, fac, n + 1);
+      mpz_mul_ui (fac, fac, n + 2);
+      mpz_clear (s[k]);
+      mpz_clear (den[k]);
     }
-  MPFR_ASSERTD (bernoulli_size > n);
-  return bernoulli_table[n];
+
+  mpz_clear (fac);
+  mpz_clear (t);
+  mpz_clear (u);
+  mpfr_free_func (s, m * sizeof (mpz_t));
+  mpfr_free_func (den, m * sizeof (mpz_t));
+  mpfr_free_func (p, m * sizeof (unsigned long));
 }
 
-void
-mpfr_bernoulli_freecache (void)
+/* Return the size of the n first entries of the table, including the
+   blocks containing them. */
+static size_t
+bernoulli_bytes (unsigned long n)
 {
-  unsigned long i;
+  unsigned long i, size;
+  size_t bytes = 0;
 
-  if (bernoulli_table != NULL)
+  for (i = 0; i < n; i++)
+    bytes += (size_t) ALLOC (bernoulli_entry (i)) * MPFR_BYTES_PER_MP_LIMB;
+  for (i = 0, size = BERNOULLI_BLOCK0; i < n; i += size, size <<= 1)
+    bytes += size * sizeof (mpz_t);
+  return bytes;
+}
+
+/* Return B[2n]*(2n+1)!, as a read-only integer which remains valid until
+   mpfr_bernoulli_freecache is called. The table may exceed the budget of
+   the caches (see budget.c), since the entries cannot be moved; it is
+   then freed by mpfr_set_cache_budget. */
+mpz_srcptr
+mpfr_bernoulli_cache (unsigned long n)
+{
+  /* Call the initialisation function of the table if it's needed */
+  MPFR_DEFERRED_INIT_CALL(&__gmpfr_bernoulli_table);
+
+  if (MPFR_UNLIKELY (n >= bernoulli_size ()))
     {
-      for (i = 0; i < bernoulli_size; i++)
+      unsigned long i, j, last;
+
+      MPFR_LOCK_WRITE (__gmpfr_bernoulli_table.lock);
+      i = __gmpfr_bernoulli_table.size;
+      if (n >= i)
         {
-          mpz_clear (bernoulli_table[i]);
+          /* The B[2n] are usually needed in increasing order, thus compute
+             some of the next ones too, so that they can be computed by
+             batches, which is much faster. */
+          last = n + n / 8;
+          if (last < n)
+            last = n;
+          for (; i <= last; i = j + 1)
+            {
+              /* The batches are limited, so that the precision for the
+                 last entry is not much larger than for the first one,
+                 and so that the memory used for the sums is bounded. */
+              j = i + MIN (i / 4, 63);
+              if (j > last)
+                j = last;
+              if (j == i)
+                mpfr_bernoulli_internal (bernoulli_entry (i), i);
+              else
+                bernoulli_batch (i, j);
+            }
+          MPFR_ATOMIC_STORE (__gmpfr_bernoulli_table.bytes,
+                             bernoulli_bytes (i));
+          MPFR_ATOMIC_STORE (__gmpfr_bernoulli_table.size, i);
         }
-      mpfr_free_func (bernoulli_table, bernoulli_alloc * sizeof (mpz_t));
-      bernoulli_table = NULL;
-      bernoulli_alloc = 0;
-      bernoulli_size = 0;
+      MPFR_UNLOCK_WRITE (__gmpfr_bernoulli_table.lock);
     }
+  return bernoulli_entry (n);
+}
+
+/* Return the size of the table, for the memory statistics and the budget
+   of the caches. It is only an estimate if the table is being updated by
+   another thread, thus no lock is needed. */
+size_t
+mpfr_bernoulli_cache_bytes (void)
+{
+  return MPFR_ATOMIC_LOAD (__gmpfr_bernoulli_table.bytes);
+}
+
+/* The caller must make sure that no other thread uses the table. */
+void
+mpfr_bernoulli_freecache (void)
+{
+  unsigned long i, k, size;
+
+  for (i = 0; i < __gmpfr_bernoulli_table.size; i++)
+    mpz_clear (bernoulli_entry (i));
+  for (k = 0, size = BERNOULLI_BLOCK0; k < BERNOULLI_NBLOCKS; k++, size <<= 1)
+    if (__gmpfr_bernoulli_table.block[k] != NULL)
+      {
+        mpfr_free_func (__gmpfr_bernoulli_table.block[k],
+                        size * sizeof (mpz_t));
+        __gmpfr_bernoulli_table.block[k] = NULL;
+      }
+  __gmpfr_bernoulli_table.size = 0;
+  __gmpfr_bernoulli_table.bytes = 0;
 }
@@ -0,0 +1,182 @@
+/* mpfr_set_cache_budget, mpfr_get_cache_budget -- memory budget of the
+   caches
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The local budget bounds the mpz_t pool of the current thread, and the
+   caches of the constants and of the Bernoulli numbers when they are local
+   to the thread. With the shared cache, these caches have a global budget.
+   (size_t) -1 means no limit, in which case nothing is checked. */
+static MPFR_THREAD_ATTR size_t local_budget = (size_t) -1;
+#if defined(MPFR_WANT_SHARED_CACHE)
+static size_t global_budget = (size_t) -1;
+# define CACHES_BUDGET global_budget
+#else
+# define CACHES_BUDGET local_budget
+#endif
+
+#ifndef MPFR_USE_LOGGING
+# define NCACHES 4
+#else
+# define NCACHES 6
+#endif
+
+/* Set c to the caches of the constants. */
+static void
+const_caches (mpfr_cache_ptr *c)
+{
+#ifndef MPFR_USE_LOGGING
+  c[0] = __gmpfr_cache_const_pi;
+  c[1] = __gmpfr_cache_const_log2;
+#else
+  c[0] = __gmpfr_normal_pi;
+  c[1] = __gmpfr_normal_log2;
+  c[4] = __gmpfr_logging_pi;
+  c[5] = __gmpfr_logging_log2;
+#endif
+  c[2] = __gmpfr_cache_const_euler;
+  c[3] = __gmpfr_cache_const_catalan;
+}
+
+/* Return the size of the caches of the constants and of the Bernoulli
+   numbers, which may be global to all threads or local to the current
+   one. No lock is taken, since this may be called while a cache is being
+   updated (see mpfr_cache_update). */
+size_t
+mpfr_caches_bytes (void)
+{
+  mpfr_cache_ptr c[NCACHES];
+  size_t n;
+  int i;
+
+  const_caches (c);
+  n = mpfr_bernoulli_cache_bytes ();
+  for (i = 0; i < NCACHES; i++)
+    n += mpfr_cache_bytes (c[i]);
+  return n;
+}
+
+/* Return non-zero iff the caches still fit in their budget once freed
+   bytes are freed and added bytes are allocated. Without the shared cache,
+   the mpz_t pool is taken into account too. */
+int
+mpfr_caches_fit (size_t freed, size_t added)
+{
+  size_t used;
+
+  if (MPFR_LIKELY (CACHES_BUDGET == (size_t) -1))
+    return 1;
+
+  used = mpfr_caches_bytes () - freed;
+#if !defined(MPFR_WANT_SHARED_CACHE)
+  {
+    mpfr_pool_stats_t p;
+
+    mpfr_pool_stats (&p);
+    used += p.bytes;
+  }
+#endif
+  return used <= CACHES_BUDGET && added <= CACHES_BUDGET - used;
+}
+
+/* Reduce the caches of the constants and of the Bernoulli numbers until
+   they take at most budget - extra bytes, the largest one first: a constant
+   is rounded to a smaller precision (or removed from its cache if very few
+   limbs would remain), and the table of the Bernoulli numbers, whose
+   entries cannot be rounded, is freed. The caller must make sure that no
+   other thread uses the caches. */
+static void
+shrink_caches (size_t budget, size_t extra)
+{
+  mpfr_cache_ptr c[NCACHES];
+
+  const_caches (c);
+  while (extra <= budget && mpfr_caches_bytes () > budget - extra)
+    {
+      size_t excess = mpfr_caches_bytes () - (budget - extra);
+      size_t bytes = 0, n;
+      int i, k = 0;
+
+      for (i = 0; i < NCACHES; i++)
+        if (mpfr_cache_bytes (c[i]) > bytes)
+          {
+            bytes = mpfr_cache_bytes (c[i]);
+            k = i;
+          }
+
+      if (mpfr_bernoulli_cache_bytes () >= bytes)
+        {
+          mpfr_bernoulli_freecache ();
+          continue;
+        }
+
+      /* number of limbs of the significand of the rounded constant */
+      n = sizeof (struct __gmpfr_cache_snapshot_s) + MPFR_MALLOC_SIZE (0);
+      n = bytes > excess + n ? (bytes - excess - n) / MPFR_BYTES_PER_MP_LIMB
+        : 0;
+      if (n >= 2)
+        mpfr_cache_shrink (c[k], (mpfr_prec_t) n * GMP_NUMB_BITS);
+      /* also if the rounding did not free anything */
+      if (mpfr_cache_bytes (c[k]) >= bytes)
+        mpfr_clear_cache (c[k]);
+    }
+}
+
+void
+mpfr_set_cache_budget (mpfr_free_cache_t way, size_t n)
+{
+  if ((unsigned int) way & MPFR_FREE_LOCAL_CACHE)
+    {
+      local_budget = n;
+      /* This pool is always local to a thread. */
+      mpfr_pool_set_max_bytes (n);
+#if !defined(MPFR_WANT_SHARED_CACHE)
+      {
+        mpfr_pool_stats_t p;
+
+        mpfr_pool_stats (&p);
+        shrink_caches (n, p.bytes);
+      }
+#endif
+    }
+  if ((unsigned int) way & MPFR_FREE_GLOBAL_CACHE)
+    {
+#if defined(MPFR_WANT_SHARED_CACHE)
+      global_budget = n;
+      shrink_caches (n, 0);
+#endif
+    }
+}
+
+size_t
+mpfr_get_cache_budget (mpfr_free_cache_t way)
+{
+  if ((unsigned int) way & MPFR_FREE_GLOBAL_CACHE)
+    {
+#if defined(MPFR_WANT_SHARED_CACHE)
+      return global_budget;
+#else
+      return (size_t) -1;
+#endif
+    }
+  return local_budget;
+}
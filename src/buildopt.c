@@ -93,6 +93,16 @@ mpfr_buildopt_sharedcache_p (void)
 #endif
 }
 
+int
+mpfr_buildopt_parallel_p (void)
+{
+#ifdef MPFR_WANT_PARALLEL
+  return 1;
+#else
+  return 0;
+#endif
+}
+
 const char *mpfr_buildopt_tune_case (void)
 {
   /* MPFR_TUNE_CASE is always defined (can be "default"). */
@@ -19,6 +19,8 @@ You should have received a copy of the GNU Lesser General Public License
 along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
+/* the snapshots are not temporary variables */
+#define MPFR_ARENA_DONT_REDEFINE
 #include "mpfr-impl.h"
 
 #if 0 /* this function is not used/documented/tested so far, it could be
@@ -27,36 +29,212 @@ If not, see <https://www.gnu.org/licenses/>. */
 void
 mpfr_init_cache (mpfr_cache_t cache, int (*func)(mpfr_ptr, mpfr_rnd_t))
 {
-  MPFR_PREC (cache->x) = 0; /* Invalid prec to detect that the cache is not
-                               valid. Maybe add a flag? */
+  cache->snap = NULL; /* no value yet */
   cache->func = func;
 }
 #endif
 
+/* Free a snapshot and all the older ones. */
+static void
+mpfr_free_snapshots (struct __gmpfr_cache_snapshot_s *snap)
+{
+  while (snap != NULL)
+    {
+      struct __gmpfr_cache_snapshot_s *old = snap->old;
+
+      mpfr_clear (snap->x);
+      mpfr_free_func (snap, sizeof (struct __gmpfr_cache_snapshot_s));
+      snap = old;
+    }
+}
+
+/* The caller must make sure that no other thread uses the cache. */
 void
 mpfr_clear_cache (mpfr_cache_t cache)
 {
-  if (MPFR_UNLIKELY (MPFR_PREC (cache->x) != 0))
+  if (MPFR_UNLIKELY (cache->snap != NULL))
     {
+      struct __gmpfr_cache_snapshot_s *snap;
+
       /* Get the cache in read-write mode */
       MPFR_LOCK_WRITE(cache->lock);
 
-      if (MPFR_LIKELY (MPFR_PREC (cache->x) != 0))
-        {
-          mpfr_clear (cache->x);
-          MPFR_PREC (cache->x) = 0;
-        }
+      snap = cache->snap;
+      cache->snap = NULL;
+      cache->bytes = 0;
 
       /* Free the cache in read-write mode */
       MPFR_UNLOCK_WRITE(cache->lock);
+
+      mpfr_free_snapshots (snap);
     }
 }
 
+/* Return the current snapshot of the cache, or NULL. */
+struct __gmpfr_cache_snapshot_s *
+mpfr_cache_snapshot (mpfr_cache_ptr cache)
+{
+#if defined(MPFR_NEED_THREAD_LOCK) && !defined(MPFR_HAVE_ATOMIC)
+  struct __gmpfr_cache_snapshot_s *snap;
+
+  /* Without atomic operations, the pointer itself must be read under
+     a lock, but not the snapshot, which is immutable. */
+  MPFR_LOCK_READ(cache->lock);
+  snap = cache->snap;
+  MPFR_UNLOCK_READ(cache->lock);
+  return snap;
+#else
+  return MPFR_ATOMIC_LOAD (cache->snap);
+#endif
+}
+
+/* Size of a snapshot of precision p, and of the snapshot s. */
+#define SNAPSHOT_BYTES(p)                               \
+  (sizeof (struct __gmpfr_cache_snapshot_s)             \
+   + MPFR_MALLOC_SIZE (MPFR_PREC2LIMBS (p)))
+#define SNAPSHOT_SIZE(s)                                \
+  (sizeof (struct __gmpfr_cache_snapshot_s)             \
+   + MPFR_MALLOC_SIZE (MPFR_GET_ALLOC_SIZE ((s)->x)))
+
+/* Return the size of the snapshots of the cache, including the older
+   ones (see mpfr_cache_update), for the memory statistics and the budget
+   of the caches. It is only an estimate if the cache is being updated by
+   another thread, thus no lock is needed. */
+size_t
+mpfr_cache_bytes (mpfr_cache_ptr cache)
+{
+  return MPFR_ATOMIC_LOAD (cache->bytes);
+}
+
+/* Replace the value of the cache by its value rounded to nearest to the
+   precision p (at most the current one), in order to reduce the memory
+   used by the cache (see budget.c). The older snapshots are freed, thus
+   the caller must make sure that no other thread uses the cache. */
+void
+mpfr_cache_shrink (mpfr_cache_ptr cache, mpfr_prec_t p)
+{
+  struct __gmpfr_cache_snapshot_s *snap, *old = cache->snap;
+
+  MPFR_ASSERTN (old != NULL);
+  if (p > MPFR_PREC (old->x))
+    p = MPFR_PREC (old->x);
+
+  snap = (struct __gmpfr_cache_snapshot_s *)
+    mpfr_allocate_func (sizeof (struct __gmpfr_cache_snapshot_s));
+  mpfr_init2 (snap->x, p);
+  /* the ternary value is the one of the constant, not of the rounding
+     of old->x */
+  snap->inexact = mpfr_cache (snap->x, cache, MPFR_RNDN);
+  snap->old = NULL;
+
+  MPFR_LOCK_WRITE(cache->lock);
+  cache->snap = snap;
+  cache->bytes = SNAPSHOT_SIZE (snap);
+  MPFR_UNLOCK_WRITE(cache->lock);
+
+  mpfr_free_snapshots (old);
+}
+
+/* Publish a snapshot of the constant in a precision at least dprec,
+   and return it. This is the only part that needs a lock, so that the
+   threads requiring a precision the cache already has can still read
+   it while the constant is recomputed. Return NULL if the snapshot does
+   not fit in the budget of the caches (see budget.c). */
+static struct __gmpfr_cache_snapshot_s *
+mpfr_cache_update (mpfr_cache_ptr cache, mpfr_prec_t dprec)
+{
+  struct __gmpfr_cache_snapshot_s *snap, *old;
+  mpfr_prec_t cprec;  /* precision of the cache */
+  size_t freed;
+
+  /* Get the cache in read-write mode */
+  MPFR_LOCK_WRITE(cache->lock);
+
+  /* Retest the precision once we get the lock (since it might have
+     changed). If there is no lock, there is no harm in this code. */
+  old = cache->snap;
+  if (MPFR_LIKELY (old == NULL || dprec > MPFR_PREC (old->x)))
+    {
+      /* No previous result in the cache or the precision of the
+         previous result is not sufficient. */
+      if (MPFR_UNLIKELY (old == NULL))  /* No previous result. */
+        cprec = dprec;
+      else
+        {
+          /* We increase the cache size by at least 10% to avoid
+             invalidating the cache many times if one performs
+             several computations with small increase of precision.
+             With the shared cache, the old snapshots are kept, and
+             a 50% increase bounds their total size to twice the size
+             of the current one. */
+          cprec = MPFR_PREC (old->x);
+#if defined(MPFR_WANT_SHARED_CACHE)
+          cprec += cprec / 2;
+#else
+          cprec += cprec / 10;
+#endif
+          if (cprec < dprec)
+            cprec = dprec;
+        }
+
+      /* Without the shared cache, the old snapshot is freed. If the
+         new one does not fit in the budget, try without the increase
+         of the precision, otherwise do not cache the constant. */
+#if defined(MPFR_WANT_SHARED_CACHE)
+      freed = 0;
+#else
+      freed = cache->bytes;
+#endif
+      if (MPFR_UNLIKELY (! mpfr_caches_fit (freed, SNAPSHOT_BYTES (cprec))))
+        {
+          cprec = dprec;
+          if (! mpfr_caches_fit (freed, SNAPSHOT_BYTES (cprec)))
+            {
+              MPFR_UNLOCK_WRITE(cache->lock);
+              return NULL;
+            }
+        }
+
+      snap = (struct __gmpfr_cache_snapshot_s *)
+        mpfr_allocate_func (sizeof (struct __gmpfr_cache_snapshot_s));
+      mpfr_init2 (snap->x, cprec);
+      /* Take the value from the file loaded by mpfr_const_cache_load if
+         it has a sufficient precision, otherwise compute it. */
+      if (! mpfr_const_cache_lookup (snap->x, &snap->inexact, cache->func,
+                                     dprec))
+        {
+          mpfr_set_prec (snap->x, cprec);
+          snap->inexact = (*cache->func) (snap->x, MPFR_RNDN);
+        }
+      /* we assume all cached constants are positive */
+      MPFR_ASSERTN (MPFR_IS_POS (snap->x)); /* TODO... */
+
+#if defined(MPFR_WANT_SHARED_CACHE)
+      snap->old = old;
+#else
+      /* no need to keep the previous value */
+      snap->old = NULL;
+      mpfr_free_snapshots (old);
+#endif
+      MPFR_ATOMIC_STORE (cache->bytes, cache->bytes - freed
+                         + SNAPSHOT_SIZE (snap));
+      MPFR_ATOMIC_STORE (cache->snap, snap);
+    }
+  else
+    snap = old;
+
+  /* Free the cache in read-write mode */
+  MPFR_UNLOCK_WRITE(cache->lock);
+
+  return snap;
+}
+
 int
 mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
 {
   mpfr_prec_t dprec = MPFR_PREC (dest);
   mpfr_prec_t cprec;  /* precision of the cache */
+  struct __gmpfr_cache_snapshot_s *snap;
   int inexact, sign;
   MPFR_SAVE_EXPO_DECL (expo);
 
@@ -65,70 +243,40 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
 
   MPFR_SAVE_EXPO_MARK (expo);
 
-  /* Get the cache in read-only mode */
-  MPFR_LOCK_READ(cache->lock);
-  /* Read the precision within the cache */
-  cprec = MPFR_PREC (cache->x);
-  if (MPFR_UNLIKELY (dprec > cprec))
+  snap = mpfr_cache_snapshot (cache);
+  if (MPFR_UNLIKELY (snap == NULL || dprec > MPFR_PREC (snap->x)))
     {
-      /* Free the cache in read-only mode */
-      /* And get the cache in read-write mode */
-      MPFR_LOCK_READ2WRITE(cache->lock);
-
-      /* Retest the precision once we get the lock (since it might have
-         changed). If there is no lock, there is no harm in this code. */
-      cprec = MPFR_PREC (cache->x);
-      if (MPFR_LIKELY (dprec > cprec))
+      snap = mpfr_cache_update (cache, dprec);
+      if (MPFR_UNLIKELY (snap == NULL))
         {
-          /* No previous result in the cache or the precision of the
-             previous result is not sufficient. */
-          if (MPFR_UNLIKELY (cprec == 0))  /* No previous result. */
-            {
-              cprec = dprec;
-              mpfr_init2 (cache->x, cprec);
-            }
-          else
-            {
-              /* We increase the cache size by at least 10% to avoid
-                 invalidating the cache many times if one performs
-                 several computations with small increase of precision. */
-              cprec += cprec / 10;
-              if (cprec < dprec)
-                cprec = dprec;
-              /* no need to keep the previous value */
-              mpfr_set_prec (cache->x, cprec);
-            }
-
-          cache->inexact = (*cache->func) (cache->x, MPFR_RNDN);
+          /* the cache would exceed its budget: compute the constant
+             directly in the target precision */
+          inexact = (*cache->func) (dest, rnd);
+          MPFR_SAVE_EXPO_FREE (expo);
+          return mpfr_check_range (dest, inexact, rnd);
         }
-
-      /* Free the cache in read-write mode */
-      /* Get the cache in read-only mode */
-      MPFR_LOCK_WRITE2READ(cache->lock);
     }
 
-  /* now cprec >= dprec is the precision of cache->x */
+  /* now cprec >= dprec is the precision of snap->x */
+  cprec = MPFR_PREC (snap->x);
   MPFR_ASSERTD (cprec >= dprec);
-  MPFR_ASSERTD (MPFR_PREC (cache->x) == cprec);
 
   /* First, check if the cache has the exact value (unlikely).
-     Else the exact value is between (assuming x=cache->x > 0):
-       x and x+ulp(x) if cache->inexact < 0,
-       x-ulp(x) and x if cache->inexact > 0,
+     Else the exact value is between (assuming x=snap->x > 0):
+       x and x+ulp(x) if snap->inexact < 0,
+       x-ulp(x) and x if snap->inexact > 0,
      and abs(x-exact) <= ulp(x)/2. */
 
-  /* we assume all cached constants are positive */
-  MPFR_ASSERTN (MPFR_IS_POS (cache->x)); /* TODO... */
-  sign = MPFR_SIGN (cache->x);
-  MPFR_EXP (dest) = MPFR_GET_EXP (cache->x);
+  sign = MPFR_SIGN (snap->x);
+  MPFR_EXP (dest) = MPFR_GET_EXP (snap->x);
   MPFR_SET_SIGN (dest, sign);
 
-  /* round cache->x from precision cprec down to precision dprec;
+  /* round snap->x from precision cprec down to precision dprec;
      since we are in extended exponent range, for the values considered
      here, an overflow is not possible (and wouldn't make much sense). */
   MPFR_RNDRAW_GEN (inexact, dest,
-                   MPFR_MANT (cache->x), cprec, rnd, sign,
-                   if (MPFR_UNLIKELY (cache->inexact == 0))
+                   MPFR_MANT (snap->x), cprec, rnd, sign,
+                   if (MPFR_UNLIKELY (snap->inexact == 0))
                      {
                        if ((_sp[0] & _ulp) == 0)
                          {
@@ -138,9 +286,9 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
                        else
                          goto addoneulp;
                      }
-                   else if (cache->inexact < 0)
+                   else if (snap->inexact < 0)
                      goto addoneulp;
-                   else /* cache->inexact > 0 */
+                   else /* snap->inexact > 0 */
                      {
                        inexact = -sign;
                        goto trunc_doit;
@@ -151,7 +299,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
 
   /* Rather a likely, this is a 100% success rate for
      all constants of MPFR */
-  if (MPFR_LIKELY (cache->inexact != 0))
+  if (MPFR_LIKELY (snap->inexact != 0))
     {
       switch (rnd)
         {
@@ -159,7 +307,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
         case MPFR_RNDD:
           if (MPFR_UNLIKELY (inexact == 0))
             {
-              inexact = cache->inexact;
+              inexact = snap->inexact;
               if (inexact > 0)
                 {
                   mpfr_nextbelow (dest);
@@ -171,7 +319,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
         case MPFR_RNDA:
           if (MPFR_UNLIKELY (inexact == 0))
             {
-              inexact = cache->inexact;
+              inexact = snap->inexact;
               if (inexact < 0)
                 {
                   mpfr_nextabove (dest);
@@ -181,15 +329,12 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
           break;
         default: /* MPFR_RNDN */
           if (MPFR_UNLIKELY(inexact == 0))
-            inexact = cache->inexact;
+            inexact = snap->inexact;
           break;
         }
     }
 
   MPFR_SAVE_EXPO_FREE (expo);
 
-  /* Free the cache in read-only mode */
-  MPFR_UNLOCK_READ(cache->lock);
-
   return mpfr_check_range (dest, inexact, rnd);
 }
@@ -24,7 +24,10 @@ If not, see <https://www.gnu.org/licenses/>. */
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_clear (mpfr_ptr m)
 {
-  mpfr_free_func (MPFR_GET_REAL_PTR (m),
-                      MPFR_MALLOC_SIZE (MPFR_GET_ALLOC_SIZE (m)));
+  /* the significand may have been allocated in the arena, or be embedded
+     in a mpfr_small_t */
+  if (MPFR_LIKELY (! MPFR_IS_EMBEDDED (m)))
+    mpfr_arena_free (MPFR_GET_REAL_PTR (m),
+                     MPFR_MALLOC_SIZE (MPFR_GET_ALLOC_SIZE (m)));
   MPFR_MANT (m) = (mp_limb_t *) 0;
 }
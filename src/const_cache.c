@@ -0,0 +1,288 @@
+/* mpfr_const_cache_load, mpfr_const_cache_save -- persistent cache of
+   the constants pi, log(2), Euler's constant and Catalan's constant
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+# define MPFR_CONST_CACHE_MMAP 1
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+#define MPFR_NEED_INTMAX_H
+#include "mpfr-impl.h"
+
+/* The file starts with the 8-byte string "MPFRcst" (with its final null
+   character) followed by the version of the format (1 byte), then come
+   the entries, each one consisting of:
+   - the index of the constant in cc_func below (1 byte);
+   - the ternary value of the rounding to nearest (1 byte: 0, 1, or 255
+     for -1);
+   - the precision of the value (8 bytes, little endian);
+   - the size s of the value in bytes (8 bytes, little endian);
+   - the value in the format of mpfr_fpif_export (s bytes).
+   Thus the file does not depend on the platform. There may be several
+   entries for the same constant, with different precisions.
+
+   The loaded file is global to all threads, as it is read-only. It is
+   kept (mapped in memory when mmap is available) until another file is
+   loaded, and its entries are imported in the caches only when needed,
+   in a precision larger than the one of the cache. */
+
+#define CC_MAGIC "MPFRcst"
+#define CC_VERSION 1
+#define CC_HEADER_SIZE 9
+#define CC_ENTRY_SIZE 18
+#define CC_NUM 4
+
+static int (*const cc_func[CC_NUM]) (mpfr_ptr, mpfr_rnd_t) = {
+  mpfr_const_pi_internal, mpfr_const_log2_internal,
+  mpfr_const_euler_internal, mpfr_const_catalan_internal };
+
+static unsigned char *cc_data = NULL;  /* contents of the loaded file */
+static size_t cc_size;                 /* size of the loaded file */
+
+static mpfr_uintmax_t
+cc_get (const unsigned char *p)
+{
+  mpfr_uintmax_t v = 0;
+  int i;
+
+  for (i = 7; i >= 0; i--)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+static int
+cc_put (FILE *f, mpfr_uintmax_t v)
+{
+  unsigned char p[8];
+  int i;
+
+  for (i = 0; i < 8; i++, v >>= 8)
+    p[i] = (unsigned char) (v & 255);
+  return fwrite (p, 1, 8, f) != 8;
+}
+
+/* Check the structure of the file (but not the values, which are checked
+   when they are imported). Return 0 if it is correct. */
+static int
+cc_check (const unsigned char *data, size_t size)
+{
+  size_t i;
+
+  if (size < CC_HEADER_SIZE || memcmp (data, CC_MAGIC, 8) != 0
+      || data[8] != CC_VERSION)
+    return 1;
+  for (i = CC_HEADER_SIZE; i < size; )
+    {
+      mpfr_uintmax_t p, s;
+
+      if (size - i < CC_ENTRY_SIZE || data[i] >= CC_NUM)
+        return 1;
+      p = cc_get (data + i + 2);
+      s = cc_get (data + i + 10);
+      if (p < MPFR_PREC_MIN || p > MPFR_PREC_MAX
+          || s > size - i - CC_ENTRY_SIZE)
+        return 1;
+      i += CC_ENTRY_SIZE + (size_t) s;
+    }
+  return 0;
+}
+
+static void
+cc_release (unsigned char *data, size_t size)
+{
+  if (data == NULL)
+    return;
+#ifdef MPFR_CONST_CACHE_MMAP
+  munmap ((void *) data, size);
+#else
+  /* The buffer is not allocated with mpfr_allocate_func, since the file
+     stays loaded after a change of the GMP memory functions. */
+  free (data);
+#endif
+}
+
+int
+mpfr_const_cache_load (const char *filename)
+{
+  unsigned char *data;
+  size_t size;
+
+  if (filename == NULL)
+    {
+      filename = getenv ("MPFR_CONST_CACHE_FILE");
+      if (filename == NULL || *filename == '\0')
+        return 0;
+    }
+
+#ifdef MPFR_CONST_CACHE_MMAP
+  {
+    struct stat st;
+    void *p;
+    int fd;
+
+    fd = open (filename, O_RDONLY);
+    if (fd < 0)
+      return 1;
+    if (fstat (fd, &st) != 0 || st.st_size < CC_HEADER_SIZE
+        || (mpfr_uintmax_t) st.st_size > (size_t) -1)
+      {
+        close (fd);
+        return 1;
+      }
+    size = (size_t) st.st_size;
+    p = mmap (NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (p == MAP_FAILED)
+      return 1;
+    data = (unsigned char *) p;
+  }
+#else
+  {
+    FILE *f;
+    long n;
+
+    f = fopen (filename, "rb");
+    if (f == NULL)
+      return 1;
+    if (fseek (f, 0, SEEK_END) != 0 || (n = ftell (f)) < CC_HEADER_SIZE
+        || fseek (f, 0, SEEK_SET) != 0)
+      {
+        fclose (f);
+        return 1;
+      }
+    size = (size_t) n;
+    data = (unsigned char *) malloc (size);
+    if (data == NULL || fread (data, 1, size, f) != size)
+      {
+        free (data);
+        fclose (f);
+        return 1;
+      }
+    fclose (f);
+  }
+#endif
+
+  if (cc_check (data, size) != 0)
+    {
+      cc_release (data, size);
+      return 1;
+    }
+
+  cc_release (cc_data, cc_size);
+  cc_data = data;
+  cc_size = size;
+  return 0;
+}
+
+int
+mpfr_const_cache_save (const char *filename)
+{
+  mpfr_cache_ptr cache[CC_NUM];
+  FILE *f;
+  int k, err;
+
+  cache[0] = __gmpfr_cache_const_pi;
+  cache[1] = __gmpfr_cache_const_log2;
+  cache[2] = __gmpfr_cache_const_euler;
+  cache[3] = __gmpfr_cache_const_catalan;
+
+  f = fopen (filename, "wb");
+  if (f == NULL)
+    return 1;
+
+  err = fwrite (CC_MAGIC, 1, 8, f) != 8 || putc (CC_VERSION, f) == EOF;
+  for (k = 0; k < CC_NUM && err == 0; k++)
+    {
+      struct __gmpfr_cache_snapshot_s *snap;
+      long pos0, pos1;
+
+      MPFR_ASSERTD (cache[k]->func == cc_func[k]);
+      snap = mpfr_cache_snapshot (cache[k]);
+      if (snap == NULL)
+        continue;
+      /* The size of the value is known only once it has been written. */
+      err = putc (k, f) == EOF
+        || putc (snap->inexact < 0 ? 255 : snap->inexact, f) == EOF
+        || cc_put (f, MPFR_PREC (snap->x)) || cc_put (f, 0)
+        || (pos0 = ftell (f)) < 0
+        || mpfr_fpif_export (f, snap->x) != 0
+        || (pos1 = ftell (f)) < 0
+        || fseek (f, pos0 - 8, SEEK_SET) != 0
+        || cc_put (f, pos1 - pos0)
+        || fseek (f, 0, SEEK_END) != 0;
+    }
+
+  if (fclose (f) != 0)
+    err = 1;
+  return err;
+}
+
+/* If the loaded file has a value of the constant computed by func in a
+   precision at least prec, set x to the value with the smallest such
+   precision (x must be initialized, its precision is changed), set
+   *inexact to its ternary value and return 1. Otherwise return 0 (x may
+   then have a different precision). */
+int
+mpfr_const_cache_lookup (mpfr_ptr x, int *inexact,
+                         int (*func) (mpfr_ptr, mpfr_rnd_t), mpfr_prec_t prec)
+{
+  unsigned char *best = NULL;
+  mpfr_uintmax_t bestp = 0;
+  size_t i;
+  int k;
+
+  if (cc_data == NULL)
+    return 0;
+  for (k = 0; k < CC_NUM && cc_func[k] != func; k++)
+    ;
+  if (k == CC_NUM)
+    return 0;
+
+  for (i = CC_HEADER_SIZE; i < cc_size;
+       i += CC_ENTRY_SIZE + (size_t) cc_get (cc_data + i + 10))
+    if (cc_data[i] == k)
+      {
+        mpfr_uintmax_t p = cc_get (cc_data + i + 2);
+
+        if (p >= (mpfr_uintmax_t) prec && (best == NULL || p < bestp))
+          {
+            best = cc_data + i;
+            bestp = p;
+          }
+      }
+  if (best == NULL)
+    return 0;
+
+  /* mpfr_fpif_import_mem does not modify the buffer, which is read-only
+     if it is mapped. */
+  if (mpfr_fpif_import_mem (x, best + CC_ENTRY_SIZE,
+                            (size_t) cc_get (best + 10)) != 0
+      || (mpfr_uintmax_t) MPFR_PREC (x) != bestp
+      || ! MPFR_IS_PURE_FP (x) || MPFR_IS_NEG (x))
+    return 0;
+  *inexact = best[1] == 0 ? 0 : best[1] == 1 ? 1 : -1;
+  return 1;
+}
@@ -32,6 +32,23 @@ mpfr_const_catalan (mpfr_ptr x, mpfr_rnd_t rnd_mode) {
   return mpfr_cache (x, __gmpfr_cache_const_catalan, rnd_mode);
 }
 
+static void
+S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2);
+
+/* Arguments of S for the parallel mode */
+struct S_arg {
+  mpz_ptr T, P, Q;
+  unsigned long n1, n2;
+};
+
+static void
+S_task (void *arg)
+{
+  struct S_arg *a = (struct S_arg *) arg;
+
+  S (a->T, a->P, a->Q, a->n1, a->n2);
+}
+
 /* return T, Q such that T/Q = sum(k!^2/(2k)!/(2k+1)^2, k=n1..n2-1) */
 static void
 S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
@@ -56,11 +73,28 @@ S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
     {
       unsigned long m = (n1 + n2) / 2;
       mpz_t T2, P2, Q2;
-      S (T, P, Q, n1, m);
       mpz_init (T2);
       mpz_init (P2);
       mpz_init (Q2);
-      S (T2, P2, Q2, m, n2);
+      if (MPFR_PARALLEL_P (n2 - n1, MPFR_BS_PARALLEL_THRESHOLD))
+        {
+          struct S_arg a;
+          mpfr_task_t task;
+
+          a.T = T2;
+          a.P = P2;
+          a.Q = Q2;
+          a.n1 = m;
+          a.n2 = n2;
+          mpfr_task_fork (&task, S_task, &a);
+          S (T, P, Q, n1, m);
+          mpfr_task_join (&task);
+        }
+      else
+        {
+          S (T, P, Q, n1, m);
+          S (T2, P2, Q2, m, n2);
+        }
       mpz_mul (T, T, Q2);
       mpz_mul (T2, T2, P);
       mpz_add (T, T, T2);
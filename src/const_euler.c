@@ -70,6 +70,40 @@ mpfr_const_euler_bs_clear (mpfr_const_euler_bs_t s)
   mpz_clear (s->V);
 }
 
+static void
+mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
+                       unsigned long n1, unsigned long n2, unsigned long N,
+                       int cont);
+static void
+mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
+                       unsigned long n1, unsigned long n2, unsigned long N,
+                       int cont);
+
+/* Arguments of mpfr_const_euler_bs_1 and mpfr_const_euler_bs_2 for the
+   parallel mode (with cont = 1) */
+typedef struct
+{
+  mpfr_const_euler_bs_struct *s;
+  mpz_ptr P, Q, T;
+  unsigned long n1, n2, N;
+} mpfr_const_euler_bs_arg;
+
+static void
+mpfr_const_euler_bs_1_task (void *arg)
+{
+  mpfr_const_euler_bs_arg *a = (mpfr_const_euler_bs_arg *) arg;
+
+  mpfr_const_euler_bs_1 (a->s, a->n1, a->n2, a->N, 1);
+}
+
+static void
+mpfr_const_euler_bs_2_task (void *arg)
+{
+  mpfr_const_euler_bs_arg *a = (mpfr_const_euler_bs_arg *) arg;
+
+  mpfr_const_euler_bs_2 (a->P, a->Q, a->T, a->n1, a->n2, a->N, 1);
+}
+
 static void
 mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
                        unsigned long n1, unsigned long n2, unsigned long N,
@@ -94,8 +128,24 @@ mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
 
       mpfr_const_euler_bs_init (L);
       mpfr_const_euler_bs_init (R);
-      mpfr_const_euler_bs_1 (L, n1, m, N, 1);
-      mpfr_const_euler_bs_1 (R, m, n2, N, 1);
+      if (MPFR_PARALLEL_P (n2 - n1, MPFR_BS_PARALLEL_THRESHOLD))
+        {
+          mpfr_const_euler_bs_arg a;
+          mpfr_task_t task;
+
+          a.s = R;
+          a.n1 = m;
+          a.n2 = n2;
+          a.N = N;
+          mpfr_task_fork (&task, mpfr_const_euler_bs_1_task, &a);
+          mpfr_const_euler_bs_1 (L, n1, m, N, 1);
+          mpfr_task_join (&task);
+        }
+      else
+        {
+          mpfr_const_euler_bs_1 (L, n1, m, N, 1);
+          mpfr_const_euler_bs_1 (R, m, n2, N, 1);
+        }
 
       mpz_init (t);
       mpz_init (u);
@@ -165,8 +215,26 @@ mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
       mpz_init (P2);
       mpz_init (Q2);
       mpz_init (T2);
-      mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1);
-      mpfr_const_euler_bs_2 (P2, Q2, T2, m, n2, N, 1);
+      if (MPFR_PARALLEL_P (n2 - n1, MPFR_BS_PARALLEL_THRESHOLD))
+        {
+          mpfr_const_euler_bs_arg a;
+          mpfr_task_t task;
+
+          a.P = P2;
+          a.Q = Q2;
+          a.T = T2;
+          a.n1 = m;
+          a.n2 = n2;
+          a.N = N;
+          mpfr_task_fork (&task, mpfr_const_euler_bs_2_task, &a);
+          mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1);
+          mpfr_task_join (&task);
+        }
+      else
+        {
+          mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1);
+          mpfr_const_euler_bs_2 (P2, Q2, T2, m, n2, N, 1);
+        }
       mpz_mul (T, T, Q2);
       mpz_mul (T2, T2, P);
       mpz_add (T, T, T2);
@@ -44,6 +44,24 @@ mpfr_const_log2 (mpfr_ptr x, mpfr_rnd_t rnd_mode) {
    Compute P[0] only when need_P is non-zero.
    Need 1+ceil(log(n2-n1)/log(2)) cells in T[],P[],Q[].
 */
+static void
+S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2, int need_P);
+
+/* Arguments of S for the parallel mode */
+struct S_arg {
+  mpz_t *T, *P, *Q;
+  unsigned long n1, n2;
+  int need_P;
+};
+
+static void
+S_task (void *arg)
+{
+  struct S_arg *a = (struct S_arg *) arg;
+
+  S (a->T, a->P, a->Q, a->n1, a->n2, a->need_P);
+}
+
 static void
 S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2, int need_P)
 {
@@ -69,8 +87,47 @@ S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2, int need_P)
       unsigned long m = (n1 / 2) + (n2 / 2) + (n1 & 1UL & n2);
       mp_bitcnt_t v, w;
 
-      S (T, P, Q, n1, m, 1);
-      S (T + 1, P + 1, Q + 1, m, n2, need_P);
+      if (MPFR_PARALLEL_P (n2 - n1, MPFR_BS_PARALLEL_THRESHOLD))
+        {
+          /* The right half is computed in its own cells, since the left
+             half uses T[1], P[1], Q[1] and the following ones. */
+          unsigned long k = MPFR_INT_CEIL_LOG2 (n2 - m) + 1, i;
+          struct S_arg a;
+          mpfr_task_t task;
+          MPFR_TMP_DECL(marker);
+
+          MPFR_TMP_MARK(marker);
+          a.T = (mpz_t *) MPFR_TMP_ALLOC (3 * k * sizeof (mpz_t));
+          a.P = a.T + k;
+          a.Q = a.T + 2 * k;
+          for (i = 0; i < k; i++)
+            {
+              mpz_init (a.T[i]);
+              mpz_init (a.P[i]);
+              mpz_init (a.Q[i]);
+            }
+          a.n1 = m;
+          a.n2 = n2;
+          a.need_P = need_P;
+          mpfr_task_fork (&task, S_task, &a);
+          S (T, P, Q, n1, m, 1);
+          mpfr_task_join (&task);
+          mpz_swap (T[1], a.T[0]);
+          mpz_swap (P[1], a.P[0]);
+          mpz_swap (Q[1], a.Q[0]);
+          for (i = 0; i < k; i++)
+            {
+              mpz_clear (a.T[i]);
+              mpz_clear (a.P[i]);
+              mpz_clear (a.Q[i]);
+            }
+          MPFR_TMP_FREE(marker);
+        }
+      else
+        {
+          S (T, P, Q, n1, m, 1);
+          S (T + 1, P + 1, Q + 1, m, n2, need_P);
+        }
       mpz_mul (T[0], T[0], Q[1]);
       mpz_mul (T[1], T[1], P[0]);
       mpz_add (T[0], T[0], T[1]);
@@ -0,0 +1,81 @@
+/* mpfr_ctx_init, mpfr_ctx_save, mpfr_ctx_load, mpfr_ctx_swap -- contexts
+   holding the state of a computation (flags, exponent range, defaults)
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* A context only holds the state that changes the results of the MPFR
+   functions. The caches of the constants, the pool and the arena are
+   resources of the thread: since an MPFR function never returns with
+   pending data in them, a computation can move from a thread to another
+   one between two calls, the caches of the new thread being used. */
+
+void
+mpfr_ctx_init (__mpfr_ctx_struct *ctx)
+{
+  ctx->_mpfr_flags = 0;
+  ctx->_mpfr_emin = MPFR_EMIN_DEFAULT;
+  ctx->_mpfr_emax = MPFR_EMAX_DEFAULT;
+  ctx->_mpfr_prec = IEEE_DBL_MANT_DIG;
+  ctx->_mpfr_rnd = MPFR_RNDN;
+}
+
+void
+mpfr_ctx_save (__mpfr_ctx_struct *ctx)
+{
+  ctx->_mpfr_flags = __gmpfr_flags;
+  ctx->_mpfr_emin = __gmpfr_emin;
+  ctx->_mpfr_emax = __gmpfr_emax;
+  ctx->_mpfr_prec = __gmpfr_default_fp_bit_precision;
+  ctx->_mpfr_rnd = __gmpfr_default_rounding_mode;
+}
+
+void
+mpfr_ctx_load (const __mpfr_ctx_struct *ctx)
+{
+  MPFR_ASSERTD ((ctx->_mpfr_flags & ~MPFR_FLAGS_ALL) == 0);
+  MPFR_ASSERTD (ctx->_mpfr_emin >= MPFR_EMIN_MIN &&
+                ctx->_mpfr_emin <= MPFR_EMIN_MAX);
+  MPFR_ASSERTD (ctx->_mpfr_emax >= MPFR_EMAX_MIN &&
+                ctx->_mpfr_emax <= MPFR_EMAX_MAX);
+  MPFR_ASSERTD (MPFR_PREC_COND (ctx->_mpfr_prec));
+  MPFR_ASSERTD (ctx->_mpfr_rnd >= MPFR_RNDN && ctx->_mpfr_rnd < MPFR_RND_MAX);
+
+  __gmpfr_flags = ctx->_mpfr_flags;
+  __gmpfr_emin = ctx->_mpfr_emin;
+  __gmpfr_emax = ctx->_mpfr_emax;
+  __gmpfr_default_fp_bit_precision = ctx->_mpfr_prec;
+  __gmpfr_default_rounding_mode = ctx->_mpfr_rnd;
+}
+
+/* Exchange the state of the current thread with the one of ctx, so that a
+   scheduler can resume a computation with mpfr_ctx_swap (ctx), and
+   suspend it with the same call, which saves its state in ctx and
+   restores the previous state of the thread. */
+void
+mpfr_ctx_swap (__mpfr_ctx_struct *ctx)
+{
+  __mpfr_ctx_struct tmp;
+
+  mpfr_ctx_save (&tmp);
+  mpfr_ctx_load (ctx);
+  *ctx = tmp;
+}
@@ -105,7 +105,7 @@ mpfr_div2_approx (mpfr_limb_ptr Q1, mpfr_limb_ptr Q0,
 #endif /* GMP_NUMB_BITS == 64 */
 
 /* Special code for PREC(q) = PREC(u) = PREC(v) = p < GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_div_1 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 {
   mpfr_prec_t p = MPFR_GET_PREC(q);
@@ -252,7 +252,7 @@ mpfr_div_1 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 
 /* Special code for PREC(q) = GMP_NUMB_BITS,
    with PREC(u), PREC(v) <= GMP_NUMB_BITS. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_div_1n (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 {
   mpfr_limb_ptr qp = MPFR_MANT(q);
@@ -389,7 +389,7 @@ mpfr_div_1n (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 
 /* Special code for GMP_NUMB_BITS < PREC(q) < 2*GMP_NUMB_BITS and
    PREC(u) = PREC(v) = PREC(q) */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_div_2 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 {
   mpfr_prec_t p = MPFR_GET_PREC(q);
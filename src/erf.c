@@ -54,6 +54,9 @@ mpfr_erf (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
   /* now x is neither NaN, Inf nor 0 */
 
+  if (MPFR_SPECULATE_P (MPFR_PREC (y)))
+    return mpfr_speculate (y, x, rnd_mode, mpfr_erf);
+
   /* first try expansion at x=0 when x is small, or asymptotic expansion
      where x is large */
 
@@ -169,6 +169,8 @@ mpfr_exp (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       __gmpfr_emin = emin;
       __gmpfr_emax = emax;
     }
+  else if (MPFR_SPECULATE_P (precy))
+    return mpfr_speculate (y, x, rnd_mode, mpfr_exp);
   else  /* General case */
     {
       if (MPFR_UNLIKELY (precy >= MPFR_EXP_THRESHOLD))
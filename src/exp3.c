@@ -185,6 +185,90 @@ mpfr_exp_rational (mpfr_ptr y, mpz_ptr p, long r, int m,
 
 #define shift (GMP_NUMB_BITS/2)
 
+/* Arguments of mpfr_exp_rational for a chunk of the bits of x in the
+   parallel mode, each chunk having its own tables */
+typedef struct
+{
+  mpfr_t t;
+  mpz_t uk;
+  long r;
+  int m;                /* 0 if the chunk is zero */
+  mpz_t *Q;
+  mpfr_prec_t *mult;
+  mpfr_task_t task;
+} mpfr_exp_3_chunk;
+
+static void
+mpfr_exp_3_task (void *arg)
+{
+  mpfr_exp_3_chunk *c = (mpfr_exp_3_chunk *) arg;
+
+  mpfr_exp_rational (c->t, c->uk, c->r, c->m, c->Q, c->mult);
+}
+
+/* Compute tmp like the "Allocate tables" to "Clear tables" part of the
+   loop of mpfr_exp_3, but with the exponentials of the iter+1 chunks
+   computed in parallel. They are multiplied in the same order, so that
+   the result is the same. */
+static void
+mpfr_exp_3_parallel (mpfr_ptr tmp, mpfr_srcptr x_copy, mpfr_exp_t ttt,
+                     int k, int iter)
+{
+  mpfr_exp_3_chunk *c;
+  unsigned long twopoweri = GMP_NUMB_BITS;
+  int i, j, loop;
+
+  c = (mpfr_exp_3_chunk *)
+    mpfr_allocate_func ((iter + 1) * sizeof (mpfr_exp_3_chunk));
+  for (i = 0; i <= iter; i++)
+    {
+      mpz_init (c[i].uk);
+      mpfr_extract (c[i].uk, x_copy, i);
+      MPFR_ASSERTD (i > 0 || mpz_cmp_ui (c[i].uk, 0) != 0);
+      if (MPFR_LIKELY (mpz_cmp_ui (c[i].uk, 0) != 0))
+        {
+          c[i].m = k - i + 1;
+          c[i].r = (i == 0 ? shift : 0) + twopoweri - ttt;
+          mpfr_init2 (c[i].t, MPFR_PREC (tmp));
+          c[i].Q = (mpz_t *)
+            mpfr_allocate_func (3 * (c[i].m + 1) * sizeof (mpz_t));
+          for (j = 0; j < 3 * (c[i].m + 1); j++)
+            mpz_init (c[i].Q[j]);
+          c[i].mult = (mpfr_prec_t *)
+            mpfr_allocate_func (2 * (c[i].m + 1) * sizeof (mpfr_prec_t));
+          mpfr_task_fork (&c[i].task, mpfr_exp_3_task, c + i);
+        }
+      else
+        c[i].m = 0;
+      MPFR_ASSERTN (i == 0 || twopoweri <= LONG_MAX/2);
+      twopoweri *= 2;
+    }
+
+  for (i = 0; i <= iter; i++)
+    {
+      if (c[i].m != 0)
+        {
+          mpfr_task_join (&c[i].task);
+          if (i == 0)
+            {
+              mpfr_swap (tmp, c[0].t);
+              for (loop = 0; loop < shift; loop++)
+                mpfr_sqr (tmp, tmp, MPFR_RNDD);
+            }
+          else
+            mpfr_mul (tmp, tmp, c[i].t, MPFR_RNDD);
+          for (j = 0; j < 3 * (c[i].m + 1); j++)
+            mpz_clear (c[i].Q[j]);
+          mpfr_free_func (c[i].Q, 3 * (c[i].m + 1) * sizeof (mpz_t));
+          mpfr_free_func (c[i].mult,
+                          2 * (c[i].m + 1) * sizeof (mpfr_prec_t));
+          mpfr_clear (c[i].t);
+        }
+      mpz_clear (c[i].uk);
+    }
+  mpfr_free_func (c, (iter + 1) * sizeof (mpfr_exp_3_chunk));
+}
+
 int
 mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
@@ -246,6 +330,14 @@ mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
       k = MPFR_INT_CEIL_LOG2 (Prec) - MPFR_LOG2_GMP_NUMB_BITS;
 
+      iter = (k <= prec_x) ? k : prec_x;
+
+      if (MPFR_PARALLEL_P (Prec, MPFR_PREC_PARALLEL_THRESHOLD))
+        {
+          mpfr_exp_3_parallel (tmp, x_copy, ttt, k, iter);
+          goto chunks_done;
+        }
+
       /* now we have to extract */
       twopoweri = GMP_NUMB_BITS;
 
@@ -264,7 +356,6 @@ mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       twopoweri *= 2;
 
       /* General case */
-      iter = (k <= prec_x) ? k : prec_x;
       for (i = 1; i <= iter; i++)
         {
           mpfr_extract (uk, x_copy, i);
@@ -283,6 +374,7 @@ mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       mpfr_free_func (P, 3*(k+2)*sizeof(mpz_t));
       mpfr_free_func (mult, 2*(k+2)*sizeof(mpfr_prec_t));
 
+    chunks_done:
       if (shift_x > 0)
         {
           MPFR_BLOCK (flags, {
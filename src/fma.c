@@ -304,3 +304,27 @@ mpfr_fma (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
   MPFR_SAVE_EXPO_FREE (expo);
   return mpfr_check_range (s, inexact, rnd_mode);
 }
+
+/* Set s[i] to x[i] * y[i] + z[i] for 0 <= i < n, and t[i] to the
+   corresponding ternary value (if t is not a null pointer).
+   Return 0 iff all the results are exact.
+   Note: mpfr_fma already has a fast path (without MPFR_SAVE_EXPO) for
+   the same precision below GMP_NUMB_BITS, thus there is nothing to hoist
+   out of the loop for the time being. */
+int
+mpfr_fma_vec (const mpfr_ptr *s, const mpfr_ptr *x, const mpfr_ptr *y,
+              const mpfr_ptr *z, unsigned long n, mpfr_rnd_t rnd_mode,
+              int *t)
+{
+  unsigned long i;
+  int inex, res = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      inex = mpfr_fma (s[i], x[i], y[i], z[i], rnd_mode);
+      res |= inex;
+      if (t != NULL)
+        t[i] = inex;
+    }
+  return res;
+}
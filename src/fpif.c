@@ -555,7 +555,7 @@ read_from_memory (ext_data_ptr h, unsigned char *buffer, size_t size)
   if (ext_data_memory->arena == NULL)
     return 0;
 
-  if (ext_data_memory->bytes_consumed + size >= ext_data_memory->bytes_size)
+  if (ext_data_memory->bytes_consumed + size > ext_data_memory->bytes_size)
     return 0;
 
   memcpy (buffer, ext_data_memory->arena + ext_data_memory->bytes_consumed, size);
@@ -577,7 +577,7 @@ write_to_memory (ext_data_ptr h, unsigned char *buffer, size_t size)
   if (buffer == NULL)
     return 0;
 
-  if (ext_data_memory->bytes_consumed + size >= ext_data_memory->bytes_size)
+  if (ext_data_memory->bytes_consumed + size > ext_data_memory->bytes_size)
     return 0;
 
   memcpy (ext_data_memory->arena + ext_data_memory->bytes_consumed, buffer, size);
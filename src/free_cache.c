@@ -21,7 +21,10 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "mpfr-impl.h"
 
-/* These caches may be global to all threads or local to the current one. */
+/* These caches may be global to all threads or local to the current one.
+   Freeing a cache of mpz_t numbers (here, the one of the Bernoulli
+   numbers) may add entries to the mpz_t pool of the current thread, thus
+   this must be done before freeing this pool. */
 static void
 mpfr_free_const_caches (void)
 {
@@ -36,41 +39,32 @@ mpfr_free_const_caches (void)
 #endif
   mpfr_clear_cache (__gmpfr_cache_const_euler);
   mpfr_clear_cache (__gmpfr_cache_const_catalan);
-}
-
-/* These caches/pools are always local to a thread. */
-static void
-mpfr_free_local_cache (void)
-{
-  /* Before freeing the mpz_t pool, we need to free any cache of
-     mpz_t numbers, since freeing such a cache may add entries to
-     the mpz_t pool. */
   mpfr_bernoulli_freecache ();
-  mpfr_free_pool ();
 }
 
 void
 mpfr_free_cache (void)
 {
-  mpfr_free_local_cache ();
   mpfr_free_const_caches ();
+  mpfr_free_pool ();
 }
 
 void
 mpfr_free_cache2 (mpfr_free_cache_t way)
 {
-  if ((unsigned int) way & MPFR_FREE_LOCAL_CACHE)
+  if ((unsigned int) way & MPFR_FREE_GLOBAL_CACHE)
     {
-      mpfr_free_local_cache ();
-#if !defined(MPFR_WANT_SHARED_CACHE)
+#if defined(MPFR_WANT_SHARED_CACHE)
       mpfr_free_const_caches ();
 #endif
     }
-  if ((unsigned int) way & MPFR_FREE_GLOBAL_CACHE)
+  if ((unsigned int) way & MPFR_FREE_LOCAL_CACHE)
     {
-#if defined(MPFR_WANT_SHARED_CACHE)
+#if !defined(MPFR_WANT_SHARED_CACHE)
       mpfr_free_const_caches ();
 #endif
+      /* This pool is always local to a thread. */
+      mpfr_free_pool ();
     }
 }
 
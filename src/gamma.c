@@ -279,6 +279,9 @@ mpfr_gamma (mpfr_ptr gamma, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
          to return a mpz_t or mpfr_t. */
     }
 
+  if (MPFR_SPECULATE_P (MPFR_PREC (gamma)))
+    return mpfr_speculate (gamma, x, rnd_mode, mpfr_gamma);
+
   MPFR_SAVE_EXPO_MARK (expo);
 
   /* check for overflow: according to (6.1.37) in Abramowitz & Stegun,
@@ -0,0 +1,183 @@
+/* mpfr_group_init2, mpfr_group_set_prec, mpfr_group_clear -- groups of
+   variables whose significands are stored in a single block
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* the groups are not temporary variables */
+#define MPFR_ARENA_DONT_REDEFINE
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#if HAVE_STDARG
+# include <stdarg.h>
+#else
+# include <varargs.h>
+#endif
+
+#include "mpfr-impl.h"
+
+/* The block starts with the table of the n variables, followed by their
+   significands, each one being preceded by its size field like a
+   significand allocated by mpfr_init2. As for a mpfr_small_t (see small.c),
+   this size is stored as a negative number, so that mpfr_clear does not
+   free the significand, and mpfr_set_prec and mpfr_prec_round allocate a
+   new one if the precision becomes too large; the variable then being an
+   ordinary one, its significand is freed by mpfr_group_set_prec and
+   mpfr_group_clear. */
+
+#define TABLE_SIZE(n)                                                   \
+  (((n) * sizeof (mpfr_ptr) + sizeof (mpfr_size_limb_t) - 1)           \
+   / sizeof (mpfr_size_limb_t) * sizeof (mpfr_size_limb_t))
+
+#define TABLE(g) ((mpfr_ptr *) (g)->_mpfr_block)
+
+size_t
+mpfr_group_get_size (mpfr_prec_t p, unsigned long n)
+{
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+  return TABLE_SIZE (n) + n * MPFR_MALLOC_SIZE (MPFR_PREC2LIMBS (p));
+}
+
+/* Set the variables of g to NaN in precision p, reallocating the block
+   of g (and copying the table of the variables) if it is too small. */
+static void
+group_setup (__mpfr_group_struct *g, mpfr_prec_t p)
+{
+  size_t bytes = mpfr_group_get_size (p, g->_mpfr_n);
+  mp_size_t s = MPFR_PREC2LIMBS (p);
+  mpfr_ptr *x;
+  char *m;
+  unsigned long i;
+
+  if (bytes > g->_mpfr_size)
+    {
+      void *block = mpfr_allocate_func (bytes);
+
+      memcpy (block, g->_mpfr_block, TABLE_SIZE (g->_mpfr_n));
+      if (g->_mpfr_allocated)
+        mpfr_free_func (g->_mpfr_block, g->_mpfr_size);
+      g->_mpfr_block = block;
+      g->_mpfr_size = bytes;
+      g->_mpfr_allocated = 1;
+    }
+
+  x = TABLE (g);
+  m = (char *) g->_mpfr_block + TABLE_SIZE (g->_mpfr_n);
+  for (i = 0; i < g->_mpfr_n; i++, m += MPFR_MALLOC_SIZE (s))
+    {
+      MPFR_PREC (x[i]) = p;
+      MPFR_EXP (x[i]) = MPFR_EXP_INVALID;
+      MPFR_SET_POS (x[i]);
+      MPFR_SET_MANT_PTR (x[i], m);
+      MPFR_SET_ALLOC_SIZE (x[i], - s);
+      MPFR_SET_NAN (x[i]);
+    }
+}
+
+/* Explicit support for K&R compiler */
+void
+#if HAVE_STDARG
+mpfr_group_init2 (__mpfr_group_struct *g, void *buf, size_t size,
+                  mpfr_prec_t p, mpfr_ptr x, ...)
+#else
+mpfr_group_init2 (va_alist)
+ va_dcl
+#endif
+{
+  va_list arg;
+  mpfr_ptr y;
+  unsigned long n;
+  size_t bytes;
+#if !HAVE_STDARG
+  __mpfr_group_struct *g;
+  void *buf;
+  size_t size;
+  mpfr_prec_t p;
+  mpfr_ptr x;
+# define GROUP_VA_START                         \
+  do {                                          \
+    va_start (arg);                             \
+    g = va_arg (arg, __mpfr_group_struct *);    \
+    buf = va_arg (arg, void *);                 \
+    size = va_arg (arg, size_t);                \
+    p = va_arg (arg, mpfr_prec_t);              \
+    x = va_arg (arg, mpfr_ptr);                 \
+  } while (0)
+#else
+# define GROUP_VA_START va_start (arg, x)
+#endif
+
+  /* First count the variables, then store them in the table. */
+  GROUP_VA_START;
+  for (n = 0, y = x; y != 0; y = (mpfr_ptr) va_arg (arg, mpfr_ptr))
+    n++;
+  va_end (arg);
+
+  /* The buffer is used if it is large enough, e.g., for a group without
+     variables, which needs no memory at all. */
+  bytes = mpfr_group_get_size (p, n);
+  g->_mpfr_n = n;
+  if (bytes <= size)
+    {
+      g->_mpfr_block = buf;
+      g->_mpfr_size = size;
+      g->_mpfr_allocated = 0;
+    }
+  else
+    {
+      g->_mpfr_block = mpfr_allocate_func (bytes);
+      g->_mpfr_size = bytes;
+      g->_mpfr_allocated = 1;
+    }
+
+  GROUP_VA_START;
+  for (n = 0, y = x; y != 0; y = (mpfr_ptr) va_arg (arg, mpfr_ptr))
+    TABLE (g)[n++] = y;
+  va_end (arg);
+
+  group_setup (g, p);
+}
+
+void
+mpfr_group_set_prec (__mpfr_group_struct *g, mpfr_prec_t p)
+{
+  unsigned long i;
+
+  /* free the significands allocated by mpfr_set_prec or mpfr_prec_round */
+  for (i = 0; i < g->_mpfr_n; i++)
+    mpfr_clear (TABLE (g)[i]);
+  group_setup (g, p);
+}
+
+void
+mpfr_group_clear (__mpfr_group_struct *g)
+{
+  unsigned long i;
+
+  for (i = 0; i < g->_mpfr_n; i++)
+    mpfr_clear (TABLE (g)[i]);
+  if (g->_mpfr_allocated)
+    mpfr_free_func (g->_mpfr_block, g->_mpfr_size);
+  g->_mpfr_block = NULL;
+  g->_mpfr_size = 0;
+  g->_mpfr_n = 0;
+  g->_mpfr_allocated = 0;
+}
@@ -19,6 +19,7 @@ You should have received a copy of the GNU Lesser General Public License
 along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
+#define MPFR_ARENA_DONT_REDEFINE
 #include "mpfr-impl.h"
 
 /* Note: the purpose of MPFR_SET_POS(x) in this function is just to
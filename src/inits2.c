@@ -20,6 +20,7 @@ You should have received a copy of the GNU Lesser General Public License
 along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
+#define MPFR_ARENA_DONT_REDEFINE
 #ifdef HAVE_CONFIG_H
 # include "config.h"
 #endif
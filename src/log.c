@@ -106,6 +106,9 @@ mpfr_log (mpfr_ptr r, mpfr_srcptr a, mpfr_rnd_t rnd_mode)
 
   q = MPFR_PREC (r);
 
+  if (MPFR_SPECULATE_P (q))
+    return mpfr_speculate (r, a, rnd_mode, mpfr_log);
+
   /* use initial precision about q+2*lg(q)+cte */
   p = q + 2 * MPFR_INT_CEIL_LOG2 (q) + 10;
   /* % ~(mpfr_prec_t)GMP_NUMB_BITS  ;
@@ -0,0 +1,82 @@
+/* mpfr_get_memory_stats, mpfr_set_memory_hook -- memory usage of MPFR
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The heap counters are updated by mpfr_allocate_func, mpfr_reallocate_func
+   and mpfr_free_func (see mpfr-gmp.c), i.e. for the memory allocated
+   directly by MPFR: significands, arena, caches, heap part of the temporary
+   memory, etc. The memory allocated by GMP for the integers used internally
+   is not counted, except the one kept in the mpz_t pool (pool_bytes). The
+   stack counters are updated by MPFR_TMP_ALLOC (see mpfr-gmp.h). */
+MPFR_THREAD_ATTR struct mpfr_memstats_s __gmpfr_memstats;
+
+/* The hook is global to all threads, like the GMP memory functions. */
+static mpfr_memory_hook_t memory_hook = NULL;
+
+void
+mpfr_memstats_update (void *old_ptr, size_t old_size,
+                      void *new_ptr, size_t new_size)
+{
+  struct mpfr_memstats_s *s = &__gmpfr_memstats;
+
+  /* Memory allocated by another thread may be freed by this one, thus
+     heap_bytes is not decreased below 0. */
+  s->heap_bytes -= MIN (old_size, s->heap_bytes);
+  if (new_size != 0)
+    {
+      s->heap_allocs++;
+      s->heap_bytes += new_size;
+      if (s->heap_bytes > s->heap_peak)
+        s->heap_peak = s->heap_bytes;
+    }
+  if (memory_hook != NULL)
+    memory_hook (old_ptr, old_size, new_ptr, new_size);
+}
+
+mpfr_memory_hook_t
+mpfr_set_memory_hook (mpfr_memory_hook_t hook)
+{
+  mpfr_memory_hook_t old = memory_hook;
+
+  memory_hook = hook;
+  return old;
+}
+
+void
+mpfr_get_memory_stats (mpfr_memory_stats_t *s)
+{
+  mpfr_pool_stats_t p;
+
+  s->heap_bytes = __gmpfr_memstats.heap_bytes;
+  s->heap_peak = __gmpfr_memstats.heap_peak;
+  s->heap_allocs = __gmpfr_memstats.heap_allocs;
+  s->stack_peak = __gmpfr_memstats.stack_peak;
+
+  mpfr_pool_stats (&p);
+  s->pool_bytes = p.bytes;
+  s->pool_hits = p.hits;
+  s->pool_misses = p.misses;
+  s->pool_discards = p.discards;
+
+  mpfr_arena_stats (s);
+  s->cache_bytes = mpfr_caches_bytes ();
+}
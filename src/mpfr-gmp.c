@@ -299,21 +299,27 @@ mpfr_assert_fail (const char *filename, int linenum,
   abort();
 }
 
+#endif /* Have gmp-impl.h */
+
 /* Performing a concentration for these indirect functions may be
    good for performance since branch prediction for indirect calls
    is not well supported by a lot of CPU's (typically they can only
-   predict a limited number of indirections). */
+   predict a limited number of indirections).
+   These functions also update the memory statistics (see memstats.c). */
 MPFR_HOT_FUNCTION_ATTR void *
 mpfr_allocate_func (size_t alloc_size)
 {
   void * (*allocate_func) (size_t);
   void * (*reallocate_func) (void *, size_t, size_t);
   void   (*free_func) (void *, size_t);
+  void *p;
 
   MPFR_ASSERTD (alloc_size > 0);
   /* Always calling with the 3 arguments smooths branch prediction. */
   mp_get_memory_functions (&allocate_func, &reallocate_func, &free_func);
-  return (*allocate_func) (alloc_size);
+  p = (*allocate_func) (alloc_size);
+  mpfr_memstats_update (NULL, 0, p, alloc_size);
+  return p;
 }
 
 MPFR_HOT_FUNCTION_ATTR void *
@@ -322,11 +328,14 @@ mpfr_reallocate_func (void * ptr, size_t old_size, size_t new_size)
   void * (*allocate_func) (size_t);
   void * (*reallocate_func) (void *, size_t, size_t);
   void   (*free_func) (void *, size_t);
+  void *p;
 
   MPFR_ASSERTD (new_size > 0);
   /* Always calling with the 3 arguments smooths branch prediction. */
   mp_get_memory_functions (&allocate_func, &reallocate_func, &free_func);
-  return (*reallocate_func) (ptr, old_size, new_size);
+  p = (*reallocate_func) (ptr, old_size, new_size);
+  mpfr_memstats_update (ptr, old_size, p, new_size);
+  return p;
 }
 
 MPFR_HOT_FUNCTION_ATTR void
@@ -340,16 +349,21 @@ mpfr_free_func (void *ptr, size_t size)
   /* Always calling with the 3 arguments smooths branch prediction. */
   mp_get_memory_functions (&allocate_func, &reallocate_func, &free_func);
   (*free_func) (ptr, size);
+  mpfr_memstats_update (ptr, size, NULL, 0);
 }
 
+#ifndef MPFR_HAVE_GMP_IMPL
+
+/* The blocks are allocated in the arena of the thread if it is enabled
+   (see arena.c). */
 void *
 mpfr_tmp_allocate (struct tmp_marker **tmp_marker, size_t size)
 {
   struct tmp_marker *head;
 
   head = (struct tmp_marker *)
-    mpfr_allocate_func (sizeof (struct tmp_marker));
-  head->ptr = mpfr_allocate_func (size);
+    mpfr_arena_allocate (sizeof (struct tmp_marker));
+  head->ptr = mpfr_arena_allocate (size);
   head->size = size;
   head->next = *tmp_marker;
   *tmp_marker = head;
@@ -364,9 +378,9 @@ mpfr_tmp_free (struct tmp_marker *tmp_marker)
   while (tmp_marker != NULL)
     {
       t = tmp_marker;
-      mpfr_free_func (t->ptr, t->size);
+      mpfr_arena_free (t->ptr, t->size);
       tmp_marker = t->next;
-      mpfr_free_func (t, sizeof (struct tmp_marker));
+      mpfr_arena_free (t, sizeof (struct tmp_marker));
     }
 }
 
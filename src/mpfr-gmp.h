@@ -89,13 +89,14 @@ extern "C" {
  ************* Define GMP Internal Interface  *********
  ******************************************************/
 
-#ifdef MPFR_HAVE_GMP_IMPL  /* with gmp build */
-
-#define mpfr_allocate_func   (*__gmp_allocate_func)
-#define mpfr_reallocate_func (*__gmp_reallocate_func)
-#define mpfr_free_func       (*__gmp_free_func)
+/* The memory allocated directly by MPFR goes through these functions,
+   which call the current GMP memory functions and update the memory
+   statistics (see memstats.c). */
+__MPFR_DECLSPEC void * mpfr_allocate_func (size_t);
+__MPFR_DECLSPEC void * mpfr_reallocate_func (void *, size_t, size_t);
+__MPFR_DECLSPEC void   mpfr_free_func (void *, size_t);
 
-#else  /* without gmp build (gmp-impl.h replacement) */
+#ifndef MPFR_HAVE_GMP_IMPL  /* without gmp build (gmp-impl.h replacement) */
 
 /* Define some macros */
 
@@ -247,10 +248,6 @@ __MPFR_DECLSPEC extern const struct bases mpfr_bases[257];
 #define MIN(l,o) ((l) < (o) ? (l) : (o))
 #define MAX(h,i) ((h) > (i) ? (h) : (i))
 
-__MPFR_DECLSPEC void * mpfr_allocate_func (size_t);
-__MPFR_DECLSPEC void * mpfr_reallocate_func (void *, size_t, size_t);
-__MPFR_DECLSPEC void   mpfr_free_func (void *, size_t);
-
 #if defined(WANT_GMP_INTERNALS) && defined(HAVE___GMPN_SBPI1_DIVAPPR_Q)
 #ifndef __gmpn_sbpi1_divappr_q
 __MPFR_DECLSPEC mp_limb_t __gmpn_sbpi1_divappr_q (mp_limb_t*,
@@ -336,25 +333,48 @@ void *alloca (size_t);
 #define MPFR_INCR_ALLOCA(N) ((void) 0)
 #endif
 
+/* Within MPFR, the stack space allocated by alloca is counted for the
+   memory statistics: TMP_MARK saves the current amount, which TMP_FREE
+   restores, so that a missing TMP_FREE is corrected by the caller. */
+#ifdef __MPFR_WITHIN_MPFR
+#define MPFR_INCR_STACK(N)                                              \
+  ((__gmpfr_memstats.stack += (N)) > __gmpfr_memstats.stack_peak ?      \
+   (void) (__gmpfr_memstats.stack_peak = __gmpfr_memstats.stack) :      \
+   (void) 0)
+#define MPFR_TMP_STACK_DECL size_t tmp_stack
+#define MPFR_TMP_STACK_MARK (tmp_stack = __gmpfr_memstats.stack)
+#define MPFR_TMP_STACK_FREE (__gmpfr_memstats.stack = tmp_stack)
+#else
+#define MPFR_INCR_STACK(N) ((void) 0)
+#define MPFR_TMP_STACK_DECL int tmp_stack
+#define MPFR_TMP_STACK_MARK (tmp_stack = 0)
+#define MPFR_TMP_STACK_FREE ((void) tmp_stack)
+#endif
+
 #define TMP_ALLOC(n) (MPFR_ASSERTD ((n) > 0),                      \
                       MPFR_LIKELY ((n) <= MPFR_ALLOCA_MAX) ?       \
-                      (MPFR_INCR_ALLOCA (n), alloca (n)) :         \
+                      (MPFR_INCR_ALLOCA (n), MPFR_INCR_STACK (n),  \
+                       alloca (n)) :                               \
                       mpfr_tmp_allocate (&tmp_marker, (n)))
 
 #else  /* MPFR_ALLOCA_MAX == 0, alloca() not needed */
 
 #define TMP_ALLOC(n) (mpfr_tmp_allocate (&tmp_marker, (n)))
+#define MPFR_TMP_STACK_DECL int tmp_stack
+#define MPFR_TMP_STACK_MARK (tmp_stack = 0)
+#define MPFR_TMP_STACK_FREE ((void) tmp_stack)
 
 #endif
 
-#define TMP_DECL(m) struct tmp_marker *tmp_marker
+#define TMP_DECL(m) struct tmp_marker *tmp_marker; MPFR_TMP_STACK_DECL
 
-#define TMP_MARK(m) (tmp_marker = 0)
+#define TMP_MARK(m) (tmp_marker = 0, MPFR_TMP_STACK_MARK)
 
 /* Note about TMP_FREE: For small precisions, tmp_marker is null as
    the allocation is done on the stack (see TMP_ALLOC above). */
-#define TMP_FREE(m) \
-  (MPFR_LIKELY (tmp_marker == NULL) ? (void) 0 : mpfr_tmp_free (tmp_marker))
+#define TMP_FREE(m)                                                     \
+  (MPFR_TMP_STACK_FREE, MPFR_LIKELY (tmp_marker == NULL) ? (void) 0 :   \
+   mpfr_tmp_free (tmp_marker))
 
 #endif  /* gmp-impl.h replacement */
 
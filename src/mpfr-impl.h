@@ -87,9 +87,12 @@ If not, see <https://www.gnu.org/licenses/>. */
    no longer used, as they sometimes gave incorrect information about
    the support of thread-local variables. A configure check is now done.
    Also defines macros related to thread locking. */
-#if defined(MPFR_WANT_SHARED_CACHE)
+#if defined(MPFR_WANT_SHARED_CACHE) || defined(MPFR_WANT_PARALLEL)
 # define MPFR_NEED_THREAD_LOCK 1
 #endif
+#if defined(MPFR_WANT_PARALLEL) && !defined(MPFR_USE_THREAD_SAFE)
+# error "The parallel mode needs thread-safe support"
+#endif
 #include "mpfr-thread.h"
 
 #ifndef MPFR_USE_MINI_GMP
@@ -200,6 +203,19 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_COLD_FUNCTION_ATTR
 #endif
 
+/* With --enable-fmv, the functions with this attribute are compiled for
+   several x86-64 micro-architecture levels, and the best version for the
+   processor is selected at load time (GCC's function multiversioning,
+   based on ifunc). This is used for the small-precision cases of the
+   basic operations, which benefit from instructions such as mulx and
+   shlx/shrx (BMI2). Note that these functions can no longer be inlined. */
+#if defined(MPFR_WANT_FMV)
+# define MPFR_TARGET_CLONES_ATTR __attribute__ ((target_clones      \
+    ("arch=x86-64-v4", "arch=x86-64-v3", "arch=x86-64-v2", "default")))
+#else
+# define MPFR_TARGET_CLONES_ATTR
+#endif
+
 /* Add MPFR_MAYBE_UNUSED after a variable declaration to avoid compiler
    warnings if it is not used.
    TODO: To be replaced by the future maybe_unused attribute (C2x) once
@@ -239,10 +255,21 @@ extern "C" {
    (including compiler options), due to the various locking methods affecting
    MPFR_DEFERRED_INIT_SLAVE_DECL and MPFR_LOCK_DECL. But since this is only
    internal, that's OK. */
-struct __gmpfr_cache_s {
+/* A value of a cached constant, rounded to nearest, with its ternary
+   value. Once published in the cache, a snapshot is never modified, so
+   that it can be read without a lock. With the shared cache, the older
+   snapshots are not freed before mpfr_clear_cache, as other threads may
+   still be reading them. */
+struct __gmpfr_cache_snapshot_s {
   mpfr_t x;
   int inexact;
+  struct __gmpfr_cache_snapshot_s *old;  /* previous snapshot or NULL */
+};
+
+struct __gmpfr_cache_s {
+  struct __gmpfr_cache_snapshot_s *snap;  /* current snapshot or NULL */
   int (*func)(mpfr_ptr, mpfr_rnd_t);
+  size_t bytes;  /* size of the snapshots, updated under the lock */
   MPFR_DEFERRED_INIT_SLAVE_DECL()
   MPFR_LOCK_DECL(lock)
 };
@@ -253,10 +280,30 @@ typedef struct __gmpfr_cache_s *mpfr_cache_ptr;
 # define MPFR_WIN_THREAD_SAFE_DLL 1
 #endif
 
+/* The flags and the exponent range are read and modified by almost all
+   the functions (see MPFR_SAVE_EXPO_MARK and MPFR_SAVE_EXPO_FREE). In a
+   shared library, the default (global-dynamic) TLS model requires a call
+   to __tls_get_addr for each of them, while with the initial-exec model,
+   the access is just an offset from the thread pointer. This model needs
+   the variables to be in the static TLS block, which is always the case
+   when the library is linked with the program; if it is loaded with
+   dlopen, the C library must have some room left in this block, which
+   is normally the case for such small variables (e.g., with glibc).
+   If this is a problem, MPFR_TLS_MODEL_ATTR can be defined to empty
+   (e.g., -DMPFR_TLS_MODEL_ATTR= in CFLAGS) to use the default model. */
+#ifndef MPFR_TLS_MODEL_ATTR
+# if defined(MPFR_USE_THREAD_SAFE) && defined(__ELF__) && \
+  !defined(MPFR_WIN_THREAD_SAFE_DLL) && __MPFR_GNUC(3,3)
+#  define MPFR_TLS_MODEL_ATTR __attribute__ ((tls_model ("initial-exec")))
+# else
+#  define MPFR_TLS_MODEL_ATTR
+# endif
+#endif
+
 #if defined(__MPFR_WITHIN_MPFR) || !defined(MPFR_WIN_THREAD_SAFE_DLL)
-extern MPFR_THREAD_ATTR mpfr_flags_t __gmpfr_flags;
-extern MPFR_THREAD_ATTR mpfr_exp_t   __gmpfr_emin;
-extern MPFR_THREAD_ATTR mpfr_exp_t   __gmpfr_emax;
+extern MPFR_THREAD_ATTR MPFR_TLS_MODEL_ATTR mpfr_flags_t __gmpfr_flags;
+extern MPFR_THREAD_ATTR MPFR_TLS_MODEL_ATTR mpfr_exp_t   __gmpfr_emin;
+extern MPFR_THREAD_ATTR MPFR_TLS_MODEL_ATTR mpfr_exp_t   __gmpfr_emax;
 extern MPFR_THREAD_ATTR mpfr_prec_t  __gmpfr_default_fp_bit_precision;
 extern MPFR_THREAD_ATTR mpfr_rnd_t   __gmpfr_default_rounding_mode;
 extern MPFR_CACHE_ATTR  mpfr_cache_t __gmpfr_cache_const_euler;
@@ -321,6 +368,21 @@ __MPFR_DECLSPEC mpfr_cache_ptr * __gmpfr_cache_const_log2_f (void);
 # define MPFR_MAKE_VARFCT(T,N)
 #endif
 
+/* Memory statistics of the current thread updated on each allocation
+   (see memstats.c) and by MPFR_TMP_ALLOC (see mpfr-gmp.h); they are
+   only used within MPFR. */
+struct mpfr_memstats_s {
+  size_t heap_bytes;            /* see mpfr_memory_stats_t */
+  size_t heap_peak;
+  unsigned long heap_allocs;
+  size_t stack;                 /* current stack used by MPFR_TMP_ALLOC */
+  size_t stack_peak;
+};
+
+#ifdef __MPFR_WITHIN_MPFR
+extern MPFR_THREAD_ATTR struct mpfr_memstats_s __gmpfr_memstats;
+#endif
+
 # define MPFR_THREAD_VAR(T,N,V)    \
   MPFR_THREAD_ATTR T N = (V);      \
   MPFR_MAKE_VARFCT (T,N)
@@ -1342,7 +1404,7 @@ typedef uintmax_t mpfr_ueexp_t;
 */
 typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
 #define MPFR_GET_ALLOC_SIZE(x) \
-  (((mp_size_t *) (void *) MPFR_MANT(x))[-1] + 0)
+  ABS (((mp_size_t *) (void *) MPFR_MANT(x))[-1] + 0)
 #define MPFR_SET_ALLOC_SIZE(x, n) \
   (((mp_size_t *) (void *) MPFR_MANT(x))[-1] = (n))
 #define MPFR_MALLOC_SIZE(s) \
@@ -1352,6 +1414,23 @@ typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
 #define MPFR_GET_REAL_PTR(x) \
   ((void *) ((mpfr_size_limb_t *) (void *) MPFR_MANT(x) - 1))
 
+/* Number of limbs to allocate when a significand of n limbs must be
+   enlarged to m > n limbs (by mpfr_set_prec and mpfr_prec_round). When
+   the precision grows by small increments, as in Ziv's loops or Newton's
+   iteration, the allocated size grows geometrically, so that the number
+   of reallocations is only logarithmic. */
+#define MPFR_GROW_ALLOC_SIZE(n,m) MAX ((m), (n) + (n) / 2)
+
+/* The significand of a mpfr_small_t can be embedded in the structure
+   (see small.c). Then its size is stored as a negative number, and it
+   must be neither reallocated nor freed. MPFR_SMALL_LIMBS gives the
+   address of the embedded significand, assuming that x is the _mpfr_x
+   field of a mpfr_small_t, without reading memory; it is used to avoid
+   reading the size field when it may not exist (MPFR_TMP_INIT). */
+#define MPFR_IS_EMBEDDED(x) \
+  (((mp_size_t *) (void *) MPFR_MANT(x))[-1] < 0)
+#define MPFR_SMALL_LIMBS(x) (((__mpfr_small_struct *) (void *) (x))->_mpfr_d)
+
 /* Temporary memory handling */
 #ifndef TMP_SALLOC
 /* GMP 4.1.x or below or internals */
@@ -1440,7 +1519,7 @@ typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
                                  MPFR_LOCK_INIT( (_cache)->lock),    \
                                  MPFR_LOCK_CLEAR((_cache)->lock))    \
   MPFR_CACHE_ATTR mpfr_cache_t _cache = {{                           \
-      {{ 0, MPFR_SIGN_POS, 0, (mp_limb_t *) 0 }}, 0, _func           \
+      (struct __gmpfr_cache_snapshot_s *) 0, _func, 0                \
       MPFR_DEFERRED_INIT_SLAVE_VALUE(_func)                          \
     }};                                                              \
   MPFR_MAKE_VARFCT (mpfr_cache_t,_cache)
@@ -1451,6 +1530,68 @@ typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
 
 #include "mparam.h"
 
+/* The values from mparam.h are only the defaults: the thresholds can be
+   changed at run time with mpfr_tune_set or mpfr_tune_load (see tune.c),
+   for instance when a binary built on some machine is run on a different
+   processor. They are global (not thread-local) and should be set before
+   any other thread uses MPFR.
+   The MPFR_*_THRESHOLD macros below expand to the current values, except
+   in tune.c, which needs the compile-time values to initialize them (it
+   defines MPFR_TUNE_DEFAULTS). The program tune/tuneup.c redefines these
+   macros after including this file. */
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+struct __gmpfr_tune_s {
+  mp_size_t   mul_threshold;    /* limbs */
+  mp_size_t   sqr_threshold;    /* limbs */
+  mp_size_t   div_threshold;    /* limbs */
+  mpfr_prec_t exp_2_threshold;  /* bits */
+  mpfr_prec_t exp_threshold;    /* bits */
+  mpfr_prec_t sincos_threshold; /* bits */
+  long        ai_threshold1;
+  long        ai_threshold2;
+  long        ai_threshold3;
+};
+
+__MPFR_DECLSPEC extern struct __gmpfr_tune_s __gmpfr_tune;
+__MPFR_DECLSPEC extern short __gmpfr_mulhigh_ktab[];
+__MPFR_DECLSPEC extern short __gmpfr_sqrhigh_ktab[];
+__MPFR_DECLSPEC extern short __gmpfr_divhigh_ktab[];
+__MPFR_DECLSPEC extern const mp_size_t __gmpfr_mulhigh_ktab_size;
+__MPFR_DECLSPEC extern const mp_size_t __gmpfr_sqrhigh_ktab_size;
+__MPFR_DECLSPEC extern const mp_size_t __gmpfr_divhigh_ktab_size;
+
+#if defined (__cplusplus)
+}
+#endif
+
+#ifndef MPFR_TUNE_DEFAULTS
+# undef  MPFR_MUL_THRESHOLD
+# define MPFR_MUL_THRESHOLD    (__gmpfr_tune.mul_threshold)
+# undef  MPFR_SQR_THRESHOLD
+# define MPFR_SQR_THRESHOLD    (__gmpfr_tune.sqr_threshold)
+# undef  MPFR_DIV_THRESHOLD
+# define MPFR_DIV_THRESHOLD    (__gmpfr_tune.div_threshold)
+# undef  MPFR_EXP_2_THRESHOLD
+# define MPFR_EXP_2_THRESHOLD  (__gmpfr_tune.exp_2_threshold)
+# undef  MPFR_EXP_THRESHOLD
+# define MPFR_EXP_THRESHOLD    (__gmpfr_tune.exp_threshold)
+# undef  MPFR_SINCOS_THRESHOLD
+# define MPFR_SINCOS_THRESHOLD (__gmpfr_tune.sincos_threshold)
+# undef  MPFR_AI_THRESHOLD1
+# define MPFR_AI_THRESHOLD1    (__gmpfr_tune.ai_threshold1)
+# undef  MPFR_AI_THRESHOLD2
+# define MPFR_AI_THRESHOLD2    (__gmpfr_tune.ai_threshold2)
+# undef  MPFR_AI_THRESHOLD3
+# define MPFR_AI_THRESHOLD3    (__gmpfr_tune.ai_threshold3)
+#endif
+
+/* Scaling factor for the MPFR_AI_THRESHOLD* values, see ai.c. */
+#define MPFR_AI_SCALE 1048576
+
 
 /******************************************************
  ******************  Useful macros  *******************
@@ -2317,7 +2458,7 @@ __MPFR_DECLSPEC extern unsigned int mpfr_log_type;
 # define MPFR_GROUP_STATIC_SIZE 16
 #endif
 
-struct mpfr_group_t {
+struct mpfr_group_s {
   size_t     alloc;
   mp_limb_t *mant;
 #if MPFR_GROUP_STATIC_SIZE != 0
@@ -2337,14 +2478,14 @@ struct mpfr_group_t {
 #endif
 };
 
-#define MPFR_GROUP_DECL(g) struct mpfr_group_t g
+#define MPFR_GROUP_DECL(g) struct mpfr_group_s g
 #define MPFR_GROUP_CLEAR(g) do {                                 \
  MPFR_LOG_MSG (("GROUP_CLEAR: ptr = 0x%lX, size = %lu\n",        \
                 (unsigned long) (g).mant,                        \
                 (unsigned long) (g).alloc));                     \
  if ((g).alloc != 0) {                                           \
    MPFR_ASSERTD ((g).mant != (g).tab);                           \
-   mpfr_free_func ((g).mant, (g).alloc);                         \
+   mpfr_arena_free ((g).mant, (g).alloc);                        \
  }} while (0)
 
 #define MPFR_GROUP_INIT_TEMPLATE(g, prec, num, handler) do {            \
@@ -2357,7 +2498,7 @@ struct mpfr_group_t {
  if (_size * (num) > MPFR_GROUP_STATIC_SIZE)                            \
    {                                                                    \
      (g).alloc = (num) * _size * sizeof (mp_limb_t);                    \
-     (g).mant = (mp_limb_t *) mpfr_allocate_func ((g).alloc);           \
+     (g).mant = (mp_limb_t *) mpfr_arena_allocate ((g).alloc);          \
    }                                                                    \
  else                                                                   \
    {                                                                    \
@@ -2407,10 +2548,10 @@ struct mpfr_group_t {
  _size = MPFR_PREC2LIMBS (_prec);                                       \
  (g).alloc = (num) * _size * sizeof (mp_limb_t);                        \
  if (_oalloc == 0)                                                      \
-   (g).mant = (mp_limb_t *) mpfr_allocate_func ((g).alloc);             \
+   (g).mant = (mp_limb_t *) mpfr_arena_allocate ((g).alloc);            \
  else                                                                   \
    (g).mant = (mp_limb_t *)                                             \
-     mpfr_reallocate_func ((g).mant, _oalloc, (g).alloc);               \
+     mpfr_arena_reallocate ((g).mant, _oalloc, (g).alloc);              \
  MPFR_LOG_MSG (("GROUP_REPREC: newptr = 0x%lX, newsize = %lu\n",        \
                 (unsigned long) (g).mant, (unsigned long) (g).alloc));  \
  handler;                                                               \
@@ -2530,6 +2671,15 @@ __MPFR_DECLSPEC void mpfr_init_cache (mpfr_cache_t,
 #endif
 __MPFR_DECLSPEC void mpfr_clear_cache (mpfr_cache_t);
 __MPFR_DECLSPEC int  mpfr_cache (mpfr_ptr, mpfr_cache_t, mpfr_rnd_t);
+__MPFR_DECLSPEC struct __gmpfr_cache_snapshot_s *
+  mpfr_cache_snapshot (mpfr_cache_ptr);
+__MPFR_DECLSPEC size_t mpfr_cache_bytes (mpfr_cache_ptr);
+__MPFR_DECLSPEC void mpfr_cache_shrink (mpfr_cache_ptr, mpfr_prec_t);
+__MPFR_DECLSPEC size_t mpfr_caches_bytes (void);
+__MPFR_DECLSPEC int mpfr_caches_fit (size_t, size_t);
+__MPFR_DECLSPEC int mpfr_const_cache_lookup (mpfr_ptr, int *,
+                                             int (*) (mpfr_ptr, mpfr_rnd_t),
+                                             mpfr_prec_t);
 
 __MPFR_DECLSPEC void mpfr_mulhigh_n (mpfr_limb_ptr, mpfr_limb_srcptr,
                                      mpfr_limb_srcptr, mp_size_t);
@@ -2553,6 +2703,7 @@ __MPFR_DECLSPEC void mpfr_rand_raw (mpfr_limb_ptr, gmp_randstate_t,
 
 __MPFR_DECLSPEC mpz_srcptr mpfr_bernoulli_cache (unsigned long);
 __MPFR_DECLSPEC void mpfr_bernoulli_freecache (void);
+__MPFR_DECLSPEC size_t mpfr_bernoulli_cache_bytes (void);
 
 __MPFR_DECLSPEC int mpfr_sincos_fast (mpfr_ptr, mpfr_ptr, mpfr_srcptr,
                                       mpfr_rnd_t);
@@ -2569,6 +2720,58 @@ __MPFR_DECLSPEC void mpfr_mpz_init (mpz_ptr);
 __MPFR_DECLSPEC void mpfr_mpz_init2 (mpz_ptr, mp_bitcnt_t);
 __MPFR_DECLSPEC void mpfr_mpz_clear (mpz_ptr);
 
+/* Statistics of the mpz_t pool of the current thread (see pool.c) */
+typedef struct {
+  unsigned long hits;      /* mpz_t taken from the pool */
+  unsigned long misses;    /* mpz_t allocated by GMP (pool empty or too
+                              small entries) */
+  unsigned long discards;  /* mpz_t freed since the pool was full */
+  size_t bytes;            /* current size of the significands in the pool */
+} mpfr_pool_stats_t;
+
+__MPFR_DECLSPEC void mpfr_pool_stats (mpfr_pool_stats_t *);
+__MPFR_DECLSPEC void mpfr_pool_set_max_bytes (size_t);
+
+__MPFR_DECLSPEC void mpfr_memstats_update (void *, size_t, void *, size_t);
+
+__MPFR_DECLSPEC void mpfr_realloc_mant (mpfr_ptr, mp_size_t);
+
+__MPFR_DECLSPEC void mpfr_free_arena (void);
+__MPFR_DECLSPEC void mpfr_arena_stats (mpfr_memory_stats_t *);
+__MPFR_DECLSPEC void *mpfr_arena_allocate (size_t);
+__MPFR_DECLSPEC void *mpfr_arena_reallocate (void *, size_t, size_t);
+__MPFR_DECLSPEC void mpfr_arena_free (void *, size_t);
+__MPFR_DECLSPEC void mpfr_tmp_init2 (mpfr_ptr, mpfr_prec_t);
+
+/* Task of the parallel mode (see parallel.c): mpfr_task_fork makes
+   func(arg) available to the worker threads, and mpfr_task_join waits
+   for its completion, computing it in the current thread if no worker
+   has taken it yet. The function is run with the exponent range and the
+   defaults that the forking thread had at the time of the fork, and with
+   cleared flags; the flags it raises are added to the ones of the thread
+   joining it. The structure is provided by the caller, typically as an
+   automatic variable. Instead of being joined, a task can be abandoned
+   by mpfr_task_detach, which gives a function freeing its data (the
+   structure included) once it is no longer used. */
+typedef struct mpfr_task_s mpfr_task_t;
+struct mpfr_task_s {
+  void (*func) (void *);
+  void *arg;
+  void (*cleanup) (void *);     /* set by mpfr_task_detach */
+  int state;                    /* see parallel.c */
+  mpfr_ctx_t ctx;               /* state in which func is run */
+  mpfr_task_t *prev, *next;     /* links in the queue of the tasks */
+};
+
+__MPFR_DECLSPEC void mpfr_task_fork (mpfr_task_t *, void (*) (void *),
+                                     void *);
+__MPFR_DECLSPEC void mpfr_task_join (mpfr_task_t *);
+__MPFR_DECLSPEC int mpfr_task_done_p (mpfr_task_t *);
+__MPFR_DECLSPEC int mpfr_task_wait_any (mpfr_task_t **, int);
+__MPFR_DECLSPEC void mpfr_task_detach (mpfr_task_t *, void (*) (void *));
+__MPFR_DECLSPEC int mpfr_speculate (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t,
+                                    mpfr_unary_func_t);
+
 __MPFR_DECLSPEC int mpfr_odd_p (mpfr_srcptr);
 
 __MPFR_DECLSPEC int mpfr_nbits_ulong (unsigned long);
@@ -2601,7 +2804,11 @@ __MPFR_DECLSPEC void flags_fout (FILE *, mpfr_flags_t);
 #endif
 
 #ifndef MPFR_POOL_NENTRIES
-# define MPFR_POOL_NENTRIES 32  /* default number of entries of the pool */
+# define MPFR_POOL_NENTRIES 256  /* default number of entries of the pool */
+#endif
+
+#ifndef MPFR_POOL_MAX_BYTES
+# define MPFR_POOL_MAX_BYTES 1048576  /* default maximal size of the pool */
 #endif
 
 #if MPFR_POOL_NENTRIES && !defined(MPFR_POOL_DONT_REDEFINE)
@@ -2618,6 +2825,73 @@ __MPFR_DECLSPEC void flags_fout (FILE *, mpfr_flags_t);
 #endif
 
 
+/*****************************************************
+ ***************  Per-thread arena  ******************
+ *****************************************************/
+
+/* Within MPFR, the variables initialized by mpfr_init2 are temporary ones
+   (see arena.c), except those defined with MPFR_ARENA_DONT_REDEFINE,
+   e.g. the caches and the functions returning variables to the user. */
+#if defined(__MPFR_WITHIN_MPFR) && !defined(MPFR_ARENA_DONT_REDEFINE)
+# undef mpfr_init2
+# define mpfr_init2 mpfr_tmp_init2
+#endif
+
+
+/******************************************************
+ *******************  Parallel mode  ******************
+ ******************************************************/
+
+/* Number of threads used by the parallel mode, including the current
+   one (see mpfr_set_num_threads); it is 1 without parallel support. */
+#if defined(MPFR_WANT_PARALLEL)
+extern unsigned int __gmpfr_num_threads;
+# define MPFR_PARALLEL_P(n,min)                                        \
+  (MPFR_UNLIKELY (MPFR_ATOMIC_LOAD (__gmpfr_num_threads) > 1)          \
+   && (n) >= (min))
+#else
+# define MPFR_PARALLEL_P(n,min) 0
+#endif
+
+/* Non-zero if the current thread evaluates the expensive functions
+   speculatively in high precision (see mpfr_set_speculation), in which
+   case they call mpfr_speculate once the special cases are handled. */
+#if defined(MPFR_WANT_PARALLEL)
+extern MPFR_THREAD_ATTR int __gmpfr_speculation;
+# define MPFR_SPECULATE_P(p)                                           \
+  (MPFR_UNLIKELY (__gmpfr_speculation)                                 \
+   && (p) >= MPFR_SPEC_PARALLEL_THRESHOLD)
+#else
+# define MPFR_SPECULATE_P(p) 0
+#endif
+
+/* Minimal number of terms of a binary splitting for which its two halves
+   are computed in parallel (const_log2.c, const_euler.c, etc.). */
+#ifndef MPFR_BS_PARALLEL_THRESHOLD
+# define MPFR_BS_PARALLEL_THRESHOLD 2048
+#endif
+
+/* Minimal working precision (in bits) for which the independent series
+   of mpfr_exp_3 and mpfr_sincos_fast (one for each chunk of the bits of
+   the argument) are computed in parallel. */
+#ifndef MPFR_PREC_PARALLEL_THRESHOLD
+# define MPFR_PREC_PARALLEL_THRESHOLD 10000
+#endif
+
+/* Minimal number of inputs of mpfr_sum for which they are accumulated in
+   parallel. */
+#ifndef MPFR_SUM_PARALLEL_THRESHOLD
+# define MPFR_SUM_PARALLEL_THRESHOLD 10000
+#endif
+
+/* Minimal target precision (in bits) for which mpfr_exp, mpfr_log,
+   mpfr_gamma, mpfr_zeta and mpfr_erf are evaluated speculatively when
+   this is enabled (see speculate.c). */
+#ifndef MPFR_SPEC_PARALLEL_THRESHOLD
+# define MPFR_SPEC_PARALLEL_THRESHOLD 1000
+#endif
+
+
 /******************************************************
  ********  Compute LOG2(LOG2(MPFR_PREC_MAX))  *********
  ******************************************************/
@@ -57,35 +57,44 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 /* If MPFR needs a lock mechanism for thread synchro...
    On 2023-04-12, this is currently used only by the shared cache,
-   when it is enabled (see mpfr-impl.h). It is better to allow several
-   concurrent readers (as this is likely to occur), but the MPFR code
-   does not require that, so that a simple mutex is sufficient. Note
-   that much time may be required in a write lock (always exclusive),
-   as it involves recomputing a value in a higher precision, but the
-   time spent in a read lock will just correspond to the copy of a
-   rounded value to the destination. So even if a simple mutex is used,
-   the wasted time should not be critical. Moreover, since a mutex is
-   simpler to implement, this may also be slightly faster in some cases
-   (but no tests have been done yet). */
+   when it is enabled (see mpfr-impl.h). Several concurrent readers are
+   allowed, as this is likely to occur: every call to mpfr_const_pi and
+   the other cached constants takes a read lock, and with a simple mutex,
+   all the threads using the same constant would be serialized even when
+   the cached precision is sufficient. A write lock (always exclusive) is
+   taken only when the value is recomputed in a higher precision. */
 #ifdef MPFR_NEED_THREAD_LOCK
 
-/* TODO: Prefer the POSIX rwlock method as it allows several readers?
-   Alternatively, implement a R/W lock in the C11 mutex version.
-   See <https://en.wikipedia.org/wiki/Readers%E2%80%93writer_lock>. */
-
 /**************************************************************************/
-/*                 ISO C11 thread-locking version (mutex)                 */
+/*             ISO C11 thread-locking version (emulated rwlock)           */
 /**************************************************************************/
 
+/* ISO C11 does not provide R/W locks, so that they are emulated with a
+   mutex and a condition variable, see
+   <https://en.wikipedia.org/wiki/Readers%E2%80%93writer_lock>.
+   The mutex is held only while updating the counters, not while the
+   lock is taken. Writers are preferred: a new reader waits as long as
+   a writer holds the lock or is waiting for it, so that a writer cannot
+   be starved by a continuous flow of readers. */
+
 #if defined (MPFR_HAVE_C11_LOCK)
-/* NOTE: This version has not been tested. */
+/* NOTE: This version has been tested only with the GNU C Library, by
+   forcing MPFR_HAVE_C11_LOCK. */
 
 #define MPFR_THREAD_LOCK_METHOD "C11"
 
 #include <threads.h>
 
+typedef struct {
+  mtx_t mutex;
+  cnd_t cond;
+  unsigned int readers;  /* number of readers holding the lock */
+  unsigned int writers;  /* number of writers holding or waiting for it */
+  int writing;           /* non-zero iff a writer holds the lock */
+} mpfr_rwlock_t;
+
 #define MPFR_LOCK_DECL(_lock)                           \
-  mtx_t _lock;
+  mpfr_rwlock_t _lock;
 
 #define MPFR_LOCK_C(E)                                  \
   do {                                                  \
@@ -96,15 +105,70 @@ If not, see <https://www.gnu.org/licenses/>. */
       }                                                 \
   } while (0)
 
-#define MPFR_LOCK_INIT(_lock)    MPFR_LOCK_C(mtx_init(&(_lock), mtx_plain))
-#define MPFR_LOCK_CLEAR(_lock)   do { mtx_destroy(&(_lock)); } while (0)
-#define MPFR_LOCK_READ(_lock)    MPFR_LOCK_C(mtx_lock(&(_lock)))
-#define MPFR_UNLOCK_READ(_lock)  MPFR_LOCK_C(mtx_unlock(&(_lock)))
-#define MPFR_LOCK_WRITE(_lock)   MPFR_LOCK_C(mtx_lock(&(_lock)))
-#define MPFR_UNLOCK_WRITE(_lock) MPFR_LOCK_C(mtx_unlock(&(_lock)))
+#define MPFR_LOCK_INIT(_lock) do {                      \
+    MPFR_LOCK_C(mtx_init(&(_lock).mutex, mtx_plain));   \
+    MPFR_LOCK_C(cnd_init(&(_lock).cond));               \
+    (_lock).readers = 0;                                \
+    (_lock).writers = 0;                                \
+    (_lock).writing = 0;                                \
+  } while (0)
 
-#define MPFR_LOCK_READ2WRITE(_lock) do {} while (0)
-#define MPFR_LOCK_WRITE2READ(_lock) do {} while (0)
+#define MPFR_LOCK_CLEAR(_lock) do {                     \
+    cnd_destroy(&(_lock).cond);                         \
+    mtx_destroy(&(_lock).mutex);                        \
+  } while (0)
+
+#define MPFR_LOCK_READ(_lock) do {                      \
+    MPFR_LOCK_C(mtx_lock(&(_lock).mutex));              \
+    while ((_lock).writers != 0)                        \
+      MPFR_LOCK_C(cnd_wait(&(_lock).cond,               \
+                           &(_lock).mutex));            \
+    (_lock).readers++;                                  \
+    MPFR_LOCK_C(mtx_unlock(&(_lock).mutex));            \
+  } while (0)
+
+#define MPFR_UNLOCK_READ(_lock) do {                    \
+    MPFR_LOCK_C(mtx_lock(&(_lock).mutex));              \
+    if (--(_lock).readers == 0 && (_lock).writers != 0) \
+      MPFR_LOCK_C(cnd_broadcast(&(_lock).cond));        \
+    MPFR_LOCK_C(mtx_unlock(&(_lock).mutex));            \
+  } while (0)
+
+#define MPFR_LOCK_WRITE(_lock) do {                     \
+    MPFR_LOCK_C(mtx_lock(&(_lock).mutex));              \
+    (_lock).writers++;                                  \
+    while ((_lock).readers != 0 || (_lock).writing)     \
+      MPFR_LOCK_C(cnd_wait(&(_lock).cond,               \
+                           &(_lock).mutex));            \
+    (_lock).writing = 1;                                \
+    MPFR_LOCK_C(mtx_unlock(&(_lock).mutex));            \
+  } while (0)
+
+#define MPFR_UNLOCK_WRITE(_lock) do {                   \
+    MPFR_LOCK_C(mtx_lock(&(_lock).mutex));              \
+    (_lock).writing = 0;                                \
+    (_lock).writers--;                                  \
+    MPFR_LOCK_C(cnd_broadcast(&(_lock).cond));          \
+    MPFR_LOCK_C(mtx_unlock(&(_lock).mutex));            \
+  } while (0)
+
+/* As with pthread below, the upgrade is not atomic: the caller must
+   check the protected data again once it holds the write lock. */
+#define MPFR_LOCK_READ2WRITE(_lock) do {                \
+    MPFR_UNLOCK_READ(_lock);                            \
+    MPFR_LOCK_WRITE(_lock);                             \
+  } while (0)
+
+/* But the downgrade is atomic, as the lock can directly be given to
+   the current thread as a reader. */
+#define MPFR_LOCK_WRITE2READ(_lock) do {                \
+    MPFR_LOCK_C(mtx_lock(&(_lock).mutex));              \
+    (_lock).writing = 0;                                \
+    (_lock).writers--;                                  \
+    (_lock).readers++;                                  \
+    MPFR_LOCK_C(cnd_broadcast(&(_lock).cond));          \
+    MPFR_LOCK_C(mtx_unlock(&(_lock).mutex));            \
+  } while (0)
 
 #define MPFR_ONCE_DECL(_once)                           \
   once_flag _once;
@@ -123,7 +187,9 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 /* Note: This uses pthread_rwlock_* functions, which is better than
    pthread_mutex_* as it allows one to have several readers, which
-   is likely to occur with the MPFR shared cache. */
+   is likely to occur with the MPFR shared cache. The upgrade and the
+   downgrade are not atomic, so that the caller must check the protected
+   data again after MPFR_LOCK_READ2WRITE (this is done in cache.c). */
 
 #elif defined (HAVE_PTHREAD)
 
@@ -207,11 +273,89 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #endif  /* MPFR_NEED_THREAD_LOCK */
 
+/* Loading and storing a pointer or an integer shared by several threads,
+   with the acquire and release semantics, so that the data published by
+   the store can be read without a lock after the load. Only the GCC
+   __atomic builtins are supported (GCC 4.7+ and compatible compilers,
+   which define __ATOMIC_ACQUIRE). Otherwise MPFR_HAVE_ATOMIC is not
+   defined, and the caller must protect the variable by a lock when
+   thread locking is needed. */
+#if defined(MPFR_NEED_THREAD_LOCK) && defined(__ATOMIC_ACQUIRE)
+# define MPFR_HAVE_ATOMIC 1
+# define MPFR_ATOMIC_LOAD(_v)     __atomic_load_n (&(_v), __ATOMIC_ACQUIRE)
+# define MPFR_ATOMIC_STORE(_v,_x)                       \
+  __atomic_store_n (&(_v), (_x), __ATOMIC_RELEASE)
+#else
+# define MPFR_ATOMIC_LOAD(_v)     (_v)
+# define MPFR_ATOMIC_STORE(_v,_x) ((void) ((_v) = (_x)))
+#endif
+
 /**************************************************************************/
 /*                     End of code for thread locking                     */
 /**************************************************************************/
 /**************************************************************************/
 
+/**************************************************************************/
+/**************************************************************************/
+/*                    Start of code for worker threads                    */
+/**************************************************************************/
+
+/* Threads created by MPFR for the parallel mode (see parallel.c), with
+   a mutex and a condition variable. MPFR_NEED_THREAD_LOCK is defined
+   together with MPFR_WANT_PARALLEL, so that the thread locking method
+   chosen above (C11 or pthread) is also used here. A worker function is
+   defined with MPFR_THREAD_FUNC and ends with MPFR_THREAD_RETURN. */
+#if defined(MPFR_WANT_PARALLEL) && defined(MPFR_NEED_THREAD_LOCK)
+
+#if defined (MPFR_HAVE_C11_LOCK)
+
+typedef thrd_t mpfr_thread_t;
+typedef mtx_t  mpfr_mutex_t;
+typedef cnd_t  mpfr_cond_t;
+
+#define MPFR_THREAD_FUNC(_f,_arg) static int _f (void *_arg)
+#define MPFR_THREAD_RETURN        return 0
+#define MPFR_THREAD_CREATE(_t,_f,_arg)                  \
+  (thrd_create (&(_t), (_f), (_arg)) == thrd_success)
+#define MPFR_THREAD_JOIN(_t)     MPFR_LOCK_C(thrd_join ((_t), NULL))
+#define MPFR_MUTEX_INIT(_m)      MPFR_LOCK_C(mtx_init (&(_m), mtx_plain))
+#define MPFR_MUTEX_CLEAR(_m)     mtx_destroy (&(_m))
+#define MPFR_MUTEX_LOCK(_m)      MPFR_LOCK_C(mtx_lock (&(_m)))
+#define MPFR_MUTEX_UNLOCK(_m)    MPFR_LOCK_C(mtx_unlock (&(_m)))
+#define MPFR_COND_INIT(_c)       MPFR_LOCK_C(cnd_init (&(_c)))
+#define MPFR_COND_CLEAR(_c)      cnd_destroy (&(_c))
+#define MPFR_COND_WAIT(_c,_m)    MPFR_LOCK_C(cnd_wait (&(_c), &(_m)))
+#define MPFR_COND_BROADCAST(_c)  MPFR_LOCK_C(cnd_broadcast (&(_c)))
+
+#else /* pthread, as MPFR_NEED_THREAD_LOCK would have failed otherwise */
+
+typedef pthread_t       mpfr_thread_t;
+typedef pthread_mutex_t mpfr_mutex_t;
+typedef pthread_cond_t  mpfr_cond_t;
+
+#define MPFR_THREAD_FUNC(_f,_arg) static void *_f (void *_arg)
+#define MPFR_THREAD_RETURN        return NULL
+#define MPFR_THREAD_CREATE(_t,_f,_arg)                  \
+  (pthread_create (&(_t), NULL, (_f), (_arg)) == 0)
+#define MPFR_THREAD_JOIN(_t)     MPFR_LOCK_C(pthread_join ((_t), NULL))
+#define MPFR_MUTEX_INIT(_m)      MPFR_LOCK_C(pthread_mutex_init (&(_m), NULL))
+#define MPFR_MUTEX_CLEAR(_m)     pthread_mutex_destroy (&(_m))
+#define MPFR_MUTEX_LOCK(_m)      MPFR_LOCK_C(pthread_mutex_lock (&(_m)))
+#define MPFR_MUTEX_UNLOCK(_m)    MPFR_LOCK_C(pthread_mutex_unlock (&(_m)))
+#define MPFR_COND_INIT(_c)       MPFR_LOCK_C(pthread_cond_init (&(_c), NULL))
+#define MPFR_COND_CLEAR(_c)      pthread_cond_destroy (&(_c))
+#define MPFR_COND_WAIT(_c,_m)    MPFR_LOCK_C(pthread_cond_wait (&(_c), &(_m)))
+#define MPFR_COND_BROADCAST(_c)  MPFR_LOCK_C(pthread_cond_broadcast (&(_c)))
+
+#endif
+
+#endif /* MPFR_WANT_PARALLEL && MPFR_NEED_THREAD_LOCK */
+
+/**************************************************************************/
+/*                     End of code for worker threads                     */
+/**************************************************************************/
+/**************************************************************************/
+
 /**************************************************************************/
 /**************************************************************************/
 /*                    Start of code for deferred init                     */
@@ -275,6 +275,79 @@ typedef __mpfr_struct mpfr_t[1];
 typedef __mpfr_struct *mpfr_ptr;
 typedef const __mpfr_struct *mpfr_srcptr;
 
+/* Vector of n numbers of the same precision, stored as parallel arrays
+   (structure of arrays): the i-th number has sign _sign[i], exponent
+   _exp[i] and significand _d[i*k] ... _d[i*k+k-1] with k as above, and
+   the same conventions as above. See mpfr_vec_init2 and mpfr_vec_view. */
+typedef struct {
+  mpfr_prec_t    _mpfr_vec_prec;
+  unsigned long  _mpfr_vec_size;
+  mpfr_sign_t   *_mpfr_vec_sign;
+  mpfr_exp_t    *_mpfr_vec_exp;
+  mp_limb_t     *_mpfr_vec_d;
+} __mpfr_vec_struct;
+
+typedef __mpfr_vec_struct mpfr_vec_t[1];
+typedef __mpfr_vec_struct *mpfr_vec_ptr;
+typedef const __mpfr_vec_struct *mpfr_vec_srcptr;
+
+/* Number with its significand embedded in the structure, for precisions up
+   to MPFR_SMALL_PREC_MAX (see mpfr_small_init2): _mpfr_x._mpfr_d points to
+   _mpfr_d, and _mpfr_h holds the size field that precedes the significand
+   (it must have the same layout as mpfr_size_limb_t in mpfr-impl.h). Such
+   a structure must not be moved or copied. */
+#define __MPFR_SMALL_LIMBS ((128 - 1) / GMP_NUMB_BITS + 1)
+#define MPFR_SMALL_PREC_MAX ((mpfr_prec_t) __MPFR_SMALL_LIMBS * GMP_NUMB_BITS)
+
+typedef struct {
+  __mpfr_struct _mpfr_x;
+  union { mp_size_t _mpfr_s; mp_limb_t _mpfr_l; } _mpfr_h;
+  mp_limb_t _mpfr_d[__MPFR_SMALL_LIMBS];
+} __mpfr_small_struct;
+
+typedef __mpfr_small_struct mpfr_small_t[1];
+
+#define mpfr_small_ptr(x) (&(x)->_mpfr_x)
+
+/* Group of variables of the same precision whose significands are stored
+   in a single block, allocated by MPFR or provided by the caller (see
+   mpfr_group_init2). */
+typedef struct {
+  void *_mpfr_block;     /* table of the variables, then the significands */
+  size_t _mpfr_size;     /* size of the block in bytes */
+  unsigned long _mpfr_n; /* number of variables */
+  int _mpfr_allocated;   /* whether the block has been allocated by MPFR */
+} __mpfr_group_struct;
+
+typedef __mpfr_group_struct mpfr_group_t[1];
+
+/* State of the current thread used by the MPFR functions: flags, exponent
+   range, default precision and rounding mode (see mpfr_ctx_swap). */
+typedef struct {
+  mpfr_flags_t _mpfr_flags;
+  mpfr_exp_t   _mpfr_emin;
+  mpfr_exp_t   _mpfr_emax;
+  mpfr_prec_t  _mpfr_prec;
+  mpfr_rnd_t   _mpfr_rnd;
+} __mpfr_ctx_struct;
+
+typedef __mpfr_ctx_struct mpfr_ctx_t[1];
+
+/* Asynchronous computation (see mpfr_async_unary); the data of the
+   computation are allocated by MPFR until mpfr_async_wait is called. */
+typedef struct {
+  void *_mpfr_task;
+} __mpfr_async_struct;
+
+typedef __mpfr_async_struct mpfr_async_t[1];
+
+/* Functions computed asynchronously, such as mpfr_const_pi, mpfr_exp and
+   mpfr_div */
+typedef int (*mpfr_const_func_t) (mpfr_ptr, mpfr_rnd_t);
+typedef int (*mpfr_unary_func_t) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+typedef int (*mpfr_binary_func_t) (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
+                                   mpfr_rnd_t);
+
 /* For those who need a direct and fast access to the sign field.
    However, it is not in the API, thus use it at your own risk: it
    might not be supported, or change name, in further versions!
@@ -297,6 +370,44 @@ typedef enum {
   MPFR_FREE_GLOBAL_CACHE = 2   /* 1 << 1 */
 } mpfr_free_cache_t;
 
+/* Memory statistics of the current thread, see mpfr_get_memory_stats */
+typedef struct {
+  size_t heap_bytes;            /* allocated by MPFR and not freed yet */
+  size_t heap_peak;             /* maximum of heap_bytes */
+  unsigned long heap_allocs;    /* number of allocations/reallocations */
+  size_t stack_peak;            /* maximum stack used by temporary memory */
+  size_t pool_bytes;            /* size of the mpz_t in the pool */
+  unsigned long pool_hits;      /* mpz_t taken from the pool */
+  unsigned long pool_misses;    /* mpz_t allocated by GMP */
+  unsigned long pool_discards;  /* mpz_t freed since the pool was full */
+  size_t arena_size;            /* size of the arena, 0 if disabled */
+  size_t arena_peak;            /* maximum used part of the arena */
+  unsigned long arena_misses;   /* blocks that did not fit in the arena */
+  size_t cache_bytes;           /* caches of the constants and Bernoulli
+                                   numbers */
+} mpfr_memory_stats_t;
+
+/* Function called on each allocation (old_ptr = NULL), reallocation or
+   free (new_ptr = NULL) done by MPFR, see mpfr_set_memory_hook */
+typedef void (*mpfr_memory_hook_t) (void *, size_t, void *, size_t);
+
+/* Tuning parameters (thresholds), see mpfr_tune_get and mpfr_tune_set */
+typedef enum {
+  MPFR_TUNE_MUL_THRESHOLD = 0,
+  MPFR_TUNE_SQR_THRESHOLD,
+  MPFR_TUNE_DIV_THRESHOLD,
+  MPFR_TUNE_EXP_2_THRESHOLD,
+  MPFR_TUNE_EXP_THRESHOLD,
+  MPFR_TUNE_SINCOS_THRESHOLD,
+  MPFR_TUNE_AI_THRESHOLD1,
+  MPFR_TUNE_AI_THRESHOLD2,
+  MPFR_TUNE_AI_THRESHOLD3,
+  MPFR_TUNE_MULHIGH_TAB,
+  MPFR_TUNE_SQRHIGH_TAB,
+  MPFR_TUNE_DIVHIGH_TAB,
+  MPFR_TUNE_MAX  /* number of parameters, not a valid parameter */
+} mpfr_tune_t;
+
 /* GMP defines:
     + size_t:                Standard size_t
     + __GMP_NOTHROW          For C++: can't throw .
@@ -413,9 +524,17 @@ __MPFR_DECLSPEC int mpfr_buildopt_float128_p     (void);
 __MPFR_DECLSPEC int mpfr_buildopt_decimal_p      (void);
 __MPFR_DECLSPEC int mpfr_buildopt_gmpinternals_p (void);
 __MPFR_DECLSPEC int mpfr_buildopt_sharedcache_p  (void);
+__MPFR_DECLSPEC int mpfr_buildopt_parallel_p     (void);
 __MPFR_DECLSPEC MPFR_RETURNS_NONNULL const char *
   mpfr_buildopt_tune_case (void);
 
+__MPFR_DECLSPEC long mpfr_tune_get   (mpfr_tune_t, long);
+__MPFR_DECLSPEC int  mpfr_tune_set   (mpfr_tune_t, long, long);
+__MPFR_DECLSPEC void mpfr_tune_reset (void);
+__MPFR_DECLSPEC int  mpfr_tune_load  (const char *);
+__MPFR_DECLSPEC int  mpfr_tune_save  (const char *);
+__MPFR_DECLSPEC int  mpfr_tune_run   (long);
+
 __MPFR_DECLSPEC mpfr_exp_t mpfr_get_emin     (void);
 __MPFR_DECLSPEC int        mpfr_set_emin     (mpfr_exp_t);
 __MPFR_DECLSPEC mpfr_exp_t mpfr_get_emin_min (void);
@@ -458,9 +577,15 @@ __MPFR_DECLSPEC mpfr_flags_t mpfr_flags_save (void);
 __MPFR_DECLSPEC void mpfr_flags_restore (mpfr_flags_t,
                                          mpfr_flags_t);
 
+__MPFR_DECLSPEC void mpfr_ctx_init (__mpfr_ctx_struct *);
+__MPFR_DECLSPEC void mpfr_ctx_save (__mpfr_ctx_struct *);
+__MPFR_DECLSPEC void mpfr_ctx_load (const __mpfr_ctx_struct *);
+__MPFR_DECLSPEC void mpfr_ctx_swap (__mpfr_ctx_struct *);
+
 __MPFR_DECLSPEC int mpfr_check_range (mpfr_ptr, int, mpfr_rnd_t);
 
 __MPFR_DECLSPEC void mpfr_init2 (mpfr_ptr, mpfr_prec_t);
+__MPFR_DECLSPEC void mpfr_small_init2 (__mpfr_small_struct *, mpfr_prec_t);
 __MPFR_DECLSPEC void mpfr_init (mpfr_ptr);
 __MPFR_DECLSPEC void mpfr_clear (mpfr_ptr);
 
@@ -470,6 +595,12 @@ __MPFR_DECLSPEC void
   mpfr_inits (mpfr_ptr, ...) __MPFR_SENTINEL_ATTR;
 __MPFR_DECLSPEC void
   mpfr_clears (mpfr_ptr, ...) __MPFR_SENTINEL_ATTR;
+__MPFR_DECLSPEC void
+  mpfr_group_init2 (__mpfr_group_struct *, void *, size_t, mpfr_prec_t,
+                    mpfr_ptr, ...) __MPFR_SENTINEL_ATTR;
+__MPFR_DECLSPEC void mpfr_group_set_prec (__mpfr_group_struct *, mpfr_prec_t);
+__MPFR_DECLSPEC void mpfr_group_clear (__mpfr_group_struct *);
+__MPFR_DECLSPEC size_t mpfr_group_get_size (mpfr_prec_t, unsigned long);
 
 __MPFR_DECLSPEC int mpfr_prec_round (mpfr_ptr, mpfr_prec_t, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_can_round (mpfr_srcptr, mpfr_exp_t, mpfr_rnd_t,
@@ -481,6 +612,8 @@ __MPFR_DECLSPEC int mpfr_set_exp (mpfr_ptr, mpfr_exp_t);
 __MPFR_DECLSPEC mpfr_prec_t mpfr_get_prec (mpfr_srcptr);
 __MPFR_DECLSPEC void mpfr_set_prec (mpfr_ptr, mpfr_prec_t);
 __MPFR_DECLSPEC void mpfr_set_prec_raw (mpfr_ptr, mpfr_prec_t);
+__MPFR_DECLSPEC void mpfr_reserve_prec (mpfr_ptr, mpfr_prec_t);
+__MPFR_DECLSPEC mpfr_prec_t mpfr_get_reserved_prec (mpfr_srcptr);
 __MPFR_DECLSPEC void mpfr_set_default_prec (mpfr_prec_t);
 __MPFR_DECLSPEC mpfr_prec_t mpfr_get_default_prec (void);
 
@@ -855,11 +988,45 @@ __MPFR_DECLSPEC int mpfr_sum (mpfr_ptr, const mpfr_ptr *, unsigned long,
                               mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_dot (mpfr_ptr, const mpfr_ptr *, const mpfr_ptr *,
                               unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_add_vec (const mpfr_ptr *, const mpfr_ptr *,
+                                  const mpfr_ptr *, unsigned long,
+                                  mpfr_rnd_t, int *);
+__MPFR_DECLSPEC int mpfr_mul_vec (const mpfr_ptr *, const mpfr_ptr *,
+                                  const mpfr_ptr *, unsigned long,
+                                  mpfr_rnd_t, int *);
+__MPFR_DECLSPEC int mpfr_fma_vec (const mpfr_ptr *, const mpfr_ptr *,
+                                  const mpfr_ptr *, const mpfr_ptr *,
+                                  unsigned long, mpfr_rnd_t, int *);
 
 __MPFR_DECLSPEC void mpfr_free_cache (void);
 __MPFR_DECLSPEC void mpfr_free_cache2 (mpfr_free_cache_t);
 __MPFR_DECLSPEC void mpfr_free_pool (void);
+__MPFR_DECLSPEC void mpfr_set_cache_budget (mpfr_free_cache_t, size_t);
+__MPFR_DECLSPEC size_t mpfr_get_cache_budget (mpfr_free_cache_t);
+__MPFR_DECLSPEC int mpfr_set_arena_size (size_t);
+__MPFR_DECLSPEC size_t mpfr_get_arena_size (void);
+__MPFR_DECLSPEC void mpfr_get_memory_stats (mpfr_memory_stats_t *);
+__MPFR_DECLSPEC mpfr_memory_hook_t mpfr_set_memory_hook (mpfr_memory_hook_t);
 __MPFR_DECLSPEC int mpfr_mp_memory_cleanup (void);
+__MPFR_DECLSPEC int mpfr_const_cache_load (const char *);
+__MPFR_DECLSPEC int mpfr_const_cache_save (const char *);
+
+__MPFR_DECLSPEC int mpfr_set_num_threads (unsigned int);
+__MPFR_DECLSPEC unsigned int mpfr_get_num_threads (void);
+__MPFR_DECLSPEC int mpfr_set_speculation (int);
+__MPFR_DECLSPEC int mpfr_get_speculation (void);
+__MPFR_DECLSPEC void mpfr_async_const (__mpfr_async_struct *,
+                                       mpfr_const_func_t, mpfr_ptr,
+                                       mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_async_unary (__mpfr_async_struct *,
+                                       mpfr_unary_func_t, mpfr_ptr,
+                                       mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_async_binary (__mpfr_async_struct *,
+                                        mpfr_binary_func_t, mpfr_ptr,
+                                        mpfr_srcptr, mpfr_srcptr,
+                                        mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_async_poll (__mpfr_async_struct *);
+__MPFR_DECLSPEC int mpfr_async_wait (__mpfr_async_struct *);
 
 __MPFR_DECLSPEC int mpfr_subnormalize (mpfr_ptr, int, mpfr_rnd_t);
 
@@ -879,6 +1046,27 @@ __MPFR_DECLSPEC void mpfr_custom_init_set (mpfr_ptr, int, mpfr_exp_t,
                                            mpfr_prec_t, void *);
 __MPFR_DECLSPEC int mpfr_custom_get_kind (mpfr_srcptr);
 
+__MPFR_DECLSPEC void mpfr_vec_init2 (mpfr_vec_ptr, unsigned long,
+                                     mpfr_prec_t);
+__MPFR_DECLSPEC void mpfr_vec_clear (mpfr_vec_ptr);
+__MPFR_DECLSPEC mpfr_prec_t mpfr_vec_get_prec (mpfr_vec_srcptr);
+__MPFR_DECLSPEC unsigned long mpfr_vec_size (mpfr_vec_srcptr);
+__MPFR_DECLSPEC void mpfr_vec_view (mpfr_ptr, mpfr_vec_srcptr,
+                                    unsigned long);
+__MPFR_DECLSPEC void mpfr_vec_update (mpfr_vec_ptr, unsigned long,
+                                      mpfr_srcptr);
+__MPFR_DECLSPEC int mpfr_vec_set (mpfr_vec_ptr, unsigned long, mpfr_srcptr,
+                                  mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_vec_get (mpfr_ptr, mpfr_vec_srcptr, unsigned long,
+                                  mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_vec_add (mpfr_vec_ptr, mpfr_vec_srcptr,
+                                  mpfr_vec_srcptr, mpfr_rnd_t, int *);
+__MPFR_DECLSPEC int mpfr_vec_mul (mpfr_vec_ptr, mpfr_vec_srcptr,
+                                  mpfr_vec_srcptr, mpfr_rnd_t, int *);
+__MPFR_DECLSPEC int mpfr_vec_fma (mpfr_vec_ptr, mpfr_vec_srcptr,
+                                  mpfr_vec_srcptr, mpfr_vec_srcptr,
+                                  mpfr_rnd_t, int *);
+
 __MPFR_DECLSPEC int mpfr_total_order_p (mpfr_srcptr, mpfr_srcptr);
 
 __MPFR_DECLSPEC int mpfr_fpif_export_mem (unsigned char *, size_t, mpfr_srcptr);
@@ -266,7 +266,7 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
    Note: this code was copied in sqr.c, function mpfr_sqr_1 (this saves a few cycles
    with respect to have this function exported). As a consequence, any change here
    should be reported in mpfr_sqr_1. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_mul_1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
             mpfr_prec_t p)
 {
@@ -367,7 +367,7 @@ mpfr_mul_1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
 
 /* Special code for prec(a) = GMP_NUMB_BITS and
    prec(b), prec(c) <= GMP_NUMB_BITS. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_mul_1n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mp_limb_t a0;
@@ -465,7 +465,7 @@ mpfr_mul_1n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
    Note: this code was copied in sqr.c, function mpfr_sqr_2 (this saves a few cycles
    with respect to have this function exported). As a consequence, any change here
    should be reported in mpfr_sqr_2. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_mul_2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
             mpfr_prec_t p)
 {
@@ -589,7 +589,7 @@ mpfr_mul_2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
 
 /* Special code for 2*GMP_NUMB_BITS < prec(a) < 3*GMP_NUMB_BITS and
    2*GMP_NUMB_BITS < prec(b), prec(c) <= 3*GMP_NUMB_BITS. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_mul_3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
             mpfr_prec_t p)
 {
@@ -910,8 +910,8 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
            exact values are a nightmare for the short product trick */
         bp = MPFR_MANT (b);
         cp = MPFR_MANT (c);
-        MPFR_STAT_STATIC_ASSERT (MPFR_MUL_THRESHOLD >= 1 &&
-                                 MPFR_SQR_THRESHOLD >= 1);
+        /* guaranteed by mpfr_tune_set */
+        MPFR_ASSERTD (MPFR_MUL_THRESHOLD >= 1 && MPFR_SQR_THRESHOLD >= 1);
         if (MPFR_UNLIKELY ((bp[0] == 0 && bp[1] == 0) ||
                            (cp[0] == 0 && cp[1] == 0)))
           {
@@ -1071,7 +1071,30 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       {
       full_multiply:
         MPFR_LOG_MSG (("Use mpn_mul\n", 0));
-        b1 = mpn_mul (tmp, MPFR_MANT (b), bn, MPFR_MANT (c), cn);
+        {
+          mp_limb_t *bp = MPFR_MANT (b), *cp = MPFR_MANT (c);
+          mp_size_t z;
+
+          /* Skip the trailing zero limbs of b and c (e.g. for an integer
+             or a dyadic number with few bits in a large precision). This
+             costs two comparisons in the usual case, where b[0] and c[0]
+             are nonzero. The loops end since the most significant limbs
+             are nonzero. */
+          for (z = 0; *bp == 0; z++)
+            {
+              bp++;
+              bn--;
+            }
+          while (*cp == 0)
+            {
+              cp++;
+              cn--;
+              z++;
+            }
+          MPN_ZERO (tmp, z);
+          b1 = bn >= cn ? mpn_mul (tmp + z, bp, bn, cp, cn)
+            : mpn_mul (tmp + z, cp, cn, bp, bn);
+        }
 
         /* now tmp[0]..tmp[k-1] contains the product of both mantissa,
            with tmp[k-1]>=2^(GMP_NUMB_BITS-2) */
@@ -1107,3 +1130,69 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
     }
   MPFR_RET (inexact);
 }
+
+#if MPFR_WANT_ASSERT >= 2
+/* use the checked mpfr_mul for the elements not handled below */
+# undef mpfr_mul
+#endif
+
+/* Set a[i] to b[i] * c[i] for 0 <= i < n, and t[i] to the corresponding
+   ternary value (if t is not a null pointer). The choice of the kernel
+   is done once from the precision of a[0]; the elements whose precisions
+   differ from it, or with a singular input, are given to mpfr_mul.
+   Return 0 iff all the results are exact. */
+int
+mpfr_mul_vec (const mpfr_ptr *a, const mpfr_ptr *b, const mpfr_ptr *c,
+              unsigned long n, mpfr_rnd_t rnd_mode, int *t)
+{
+  unsigned long i;
+  int inex, res = 0;
+
+#if !defined(MPFR_GENERIC_ABI)
+#define MUL_VEC_LOOP(KERNEL)                                            \
+  for (i = 0; i < n; i++)                                               \
+    {                                                                   \
+      if (MPFR_LIKELY (MPFR_PREC (a[i]) == p && MPFR_PREC (b[i]) == p   \
+                       && MPFR_PREC (c[i]) == p                         \
+                       && ! MPFR_ARE_SINGULAR (b[i], c[i])))            \
+        inex = KERNEL;                                                  \
+      else                                                              \
+        inex = mpfr_mul (a[i], b[i], c[i], rnd_mode);                   \
+      res |= inex;                                                      \
+      if (t != NULL)                                                    \
+        t[i] = inex;                                                    \
+    }                                                                   \
+  return res
+
+  if (n != 0)
+    {
+      mpfr_prec_t p = MPFR_GET_PREC (a[0]);
+
+      if (p < GMP_NUMB_BITS)
+        {
+          MUL_VEC_LOOP (mpfr_mul_1 (a[i], b[i], c[i], rnd_mode, p));
+        }
+      if (GMP_NUMB_BITS < p && p < 2 * GMP_NUMB_BITS)
+        {
+          MUL_VEC_LOOP (mpfr_mul_2 (a[i], b[i], c[i], rnd_mode, p));
+        }
+      if (p == GMP_NUMB_BITS)
+        {
+          MUL_VEC_LOOP (mpfr_mul_1n (a[i], b[i], c[i], rnd_mode));
+        }
+      if (2 * GMP_NUMB_BITS < p && p < 3 * GMP_NUMB_BITS)
+        {
+          MUL_VEC_LOOP (mpfr_mul_3 (a[i], b[i], c[i], rnd_mode, p));
+        }
+    }
+#endif
+
+  for (i = 0; i < n; i++)
+    {
+      inex = mpfr_mul (a[i], b[i], c[i], rnd_mode);
+      res |= inex;
+      if (t != NULL)
+        t[i] = inex;
+    }
+  return res;
+}
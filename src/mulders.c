@@ -30,12 +30,13 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
-/* Don't use MPFR_MULHIGH_SIZE since it is handled by tuneup */
+/* Don't use MPFR_MULHIGH_SIZE since it is handled by tuneup.
+   Otherwise the tables can be changed at run time, see tune.c. */
 #ifdef MPFR_MULHIGH_TAB_SIZE
 static short mulhigh_ktab[MPFR_MULHIGH_TAB_SIZE];
 #else
-static short mulhigh_ktab[] = {MPFR_MULHIGH_TAB};
-#define MPFR_MULHIGH_TAB_SIZE (numberof_const (mulhigh_ktab))
+#define mulhigh_ktab __gmpfr_mulhigh_ktab
+#define MPFR_MULHIGH_TAB_SIZE __gmpfr_mulhigh_ktab_size
 #endif
 
 /* Put in  rp[n..2n-1] an approximation of the n high limbs
@@ -72,7 +73,7 @@ mpfr_mulhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mpfr_limb_srcptr mp,
 {
   mp_size_t k;
 
-  MPFR_STAT_STATIC_ASSERT (MPFR_MULHIGH_TAB_SIZE >= 8); /* so that 3*(n/4) > n/2 */
+  MPFR_ASSERTD (MPFR_MULHIGH_TAB_SIZE >= 8); /* so that 3*(n/4) > n/2 */
   k = MPFR_LIKELY (n < MPFR_MULHIGH_TAB_SIZE) ? mulhigh_ktab[n] : 3*(n/4);
   /* Algorithm ShortMul from [1] requires k >= (n+3)/2, which translates
      into k >= (n+4)/2 in the C language. */
@@ -100,8 +101,8 @@ mpfr_mulhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mpfr_limb_srcptr mp,
 #ifdef MPFR_SQRHIGH_TAB_SIZE
 static short sqrhigh_ktab[MPFR_SQRHIGH_TAB_SIZE];
 #else
-static short sqrhigh_ktab[] = {MPFR_SQRHIGH_TAB};
-#define MPFR_SQRHIGH_TAB_SIZE (numberof_const (sqrhigh_ktab))
+#define sqrhigh_ktab __gmpfr_sqrhigh_ktab
+#define MPFR_SQRHIGH_TAB_SIZE __gmpfr_sqrhigh_ktab_size
 #endif
 
 /* Put in  rp[n..2n-1] an approximation of the n high limbs
@@ -111,7 +112,7 @@ mpfr_sqrhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mp_size_t n)
 {
   mp_size_t k;
 
-  MPFR_STAT_STATIC_ASSERT (MPFR_SQRHIGH_TAB_SIZE > 2); /* ensures k < n */
+  MPFR_ASSERTD (MPFR_SQRHIGH_TAB_SIZE > 2); /* ensures k < n */
   k = MPFR_LIKELY (n < MPFR_SQRHIGH_TAB_SIZE) ? sqrhigh_ktab[n]
     : (n+4)/2; /* ensures that k >= (n+3)/2 */
   MPFR_ASSERTD (k == -1 || k == 0 || (k >= (n+4)/2 && k < n));
@@ -139,8 +140,8 @@ mpfr_sqrhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mp_size_t n)
 #ifdef MPFR_DIVHIGH_TAB_SIZE
 static short divhigh_ktab[MPFR_DIVHIGH_TAB_SIZE];
 #else
-static short divhigh_ktab[] = {MPFR_DIVHIGH_TAB};
-#define MPFR_DIVHIGH_TAB_SIZE (numberof_const (divhigh_ktab))
+#define divhigh_ktab __gmpfr_divhigh_ktab
+#define MPFR_DIVHIGH_TAB_SIZE __gmpfr_divhigh_ktab_size
 #endif
 
 /* Put in Q={qp, n} an approximation of N={np, 2*n} divided by D={dp, n},
@@ -247,7 +248,7 @@ mpfr_divhigh_n (mpfr_limb_ptr qp, mpfr_limb_ptr np, mpfr_limb_ptr dp,
     (("n=%Pd", (mpfr_prec_t) n),
      ("k=%Pd qh=%Mu", (mpfr_prec_t) k, k == 0 ? MPFR_LIMB_ZERO : qh));
 
-  MPFR_STAT_STATIC_ASSERT (MPFR_DIVHIGH_TAB_SIZE >= 15); /* so that 2*(n/3) >= (n+4)/2 */
+  MPFR_ASSERTD (MPFR_DIVHIGH_TAB_SIZE >= 15); /* so that 2*(n/3) >= (n+4)/2 */
   MPFR_ASSERTD(n >= 2);
   k = MPFR_LIKELY (n < MPFR_DIVHIGH_TAB_SIZE) ? divhigh_ktab[n] : 2*(n/3);
 
@@ -0,0 +1,377 @@
+/* mpfr_set_num_threads, mpfr_get_num_threads -- parallel mode, with a
+   pool of worker threads running the tasks forked by the MPFR functions
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* States of a task */
+#define TASK_QUEUED  0
+#define TASK_RUNNING 1
+#define TASK_DONE    2
+
+#if defined(MPFR_WANT_PARALLEL)
+
+/* The number of threads is global to the process, like the workers. */
+unsigned int __gmpfr_num_threads = 1;
+
+/* The forked tasks are in a single queue, protected by a mutex: new
+   tasks are added at the head. A thread waiting for a task it has forked
+   takes the most recent tasks (the smallest ones in a recursion, likely
+   forked by itself), and an idle worker takes the oldest ones (the
+   largest ones), like in work stealing. A thread waiting for a task
+   being computed by a worker thus never blocks while there are tasks in
+   the queue, so that nested forks cannot deadlock. A single condition
+   variable is used for new tasks, completed tasks and the termination of
+   the workers, with a broadcast, since the number of threads is small. */
+static struct {
+  MPFR_ONCE_DECL (once)
+  mpfr_mutex_t mutex;
+  mpfr_cond_t cond;
+  mpfr_task_t *head, *tail;     /* queue of the tasks */
+  mpfr_thread_t *threads;       /* worker threads */
+  size_t size;                  /* allocated size of the threads table */
+  unsigned int nworkers;        /* number of worker threads */
+  int stop;                     /* non-zero to terminate the workers */
+} workers = { MPFR_ONCE_INIT_VALUE };
+
+static void
+workers_init (void)
+{
+  MPFR_MUTEX_INIT (workers.mutex);
+  MPFR_COND_INIT (workers.cond);
+}
+
+/* Remove t from the queue, the mutex being held. */
+static void
+dequeue (mpfr_task_t *t)
+{
+  if (t->prev != NULL)
+    t->prev->next = t->next;
+  else
+    workers.head = t->next;
+  if (t->next != NULL)
+    t->next->prev = t->prev;
+  else
+    workers.tail = t->prev;
+}
+
+/* Run t, which has just been removed from the queue, the mutex being
+   held (it is released during the computation). The state of the current
+   thread is replaced by the one of the task during the computation, and
+   the state of the task after it, with the raised flags, is kept in t. */
+static void
+run (mpfr_task_t *t)
+{
+  void (*cleanup) (void *);
+
+  t->state = TASK_RUNNING;
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+  mpfr_ctx_swap (t->ctx);
+  t->func (t->arg);
+  mpfr_ctx_swap (t->ctx);
+  MPFR_MUTEX_LOCK (workers.mutex);
+  t->state = TASK_DONE;
+  cleanup = t->cleanup;
+  if (cleanup != NULL)
+    {
+      /* t has been detached while it was running: nobody waits for it,
+         and its data may be freed (t included). */
+      MPFR_MUTEX_UNLOCK (workers.mutex);
+      cleanup (t->arg);
+      MPFR_MUTEX_LOCK (workers.mutex);
+    }
+  else
+    MPFR_COND_BROADCAST (workers.cond);
+}
+
+MPFR_THREAD_FUNC (worker, arg)
+{
+  (void) arg;
+  MPFR_MUTEX_LOCK (workers.mutex);
+  while (!workers.stop)
+    {
+      mpfr_task_t *t = workers.tail;
+
+      if (t != NULL)
+        {
+          dequeue (t);
+          run (t);
+        }
+      else
+        {
+          /* The memory kept by this thread (mpz_t pool, caches) is freed
+             before waiting, so that it is not held while idle, and that
+             mpfr_mp_memory_cleanup works as expected. */
+          MPFR_MUTEX_UNLOCK (workers.mutex);
+          mpfr_free_cache2 (MPFR_FREE_LOCAL_CACHE);
+          MPFR_MUTEX_LOCK (workers.mutex);
+          if (workers.tail == NULL && !workers.stop)
+            MPFR_COND_WAIT (workers.cond, workers.mutex);
+        }
+    }
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+  /* The workers may be terminated just after a detached task, whose
+     thread has not waited since. */
+  mpfr_free_cache2 (MPFR_FREE_LOCAL_CACHE);
+  MPFR_THREAD_RETURN;
+}
+
+void
+mpfr_task_fork (mpfr_task_t *t, void (*func) (void *), void *arg)
+{
+  t->func = func;
+  t->arg = arg;
+  t->cleanup = NULL;
+  MPFR_MUTEX_LOCK (workers.mutex);
+  if (workers.nworkers == 0)
+    {
+      /* mpfr_set_num_threads (1) has been called in the meantime */
+      MPFR_MUTEX_UNLOCK (workers.mutex);
+      func (arg);
+      t->ctx->_mpfr_flags = 0;
+      t->state = TASK_DONE;
+      return;
+    }
+  mpfr_ctx_save (t->ctx);
+  t->ctx->_mpfr_flags = 0;
+  t->state = TASK_QUEUED;
+  t->prev = NULL;
+  t->next = workers.head;
+  if (workers.head != NULL)
+    workers.head->prev = t;
+  else
+    workers.tail = t;
+  workers.head = t;
+  MPFR_COND_BROADCAST (workers.cond);
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+}
+
+void
+mpfr_task_join (mpfr_task_t *t)
+{
+  MPFR_MUTEX_LOCK (workers.mutex);
+  while (t->state != TASK_DONE)
+    {
+      mpfr_task_t *u = t->state == TASK_QUEUED ? t : workers.head;
+
+      if (u != NULL)
+        {
+          dequeue (u);
+          run (u);
+        }
+      else
+        MPFR_COND_WAIT (workers.cond, workers.mutex);
+    }
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+  __gmpfr_flags |= t->ctx->_mpfr_flags;
+}
+
+int
+mpfr_task_done_p (mpfr_task_t *t)
+{
+  int done;
+
+  MPFR_MUTEX_LOCK (workers.mutex);
+  done = t->state == TASK_DONE;
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+  return done;
+}
+
+/* Wait until one of the n tasks of t, the null pointers being ignored,
+   is done, and return its index. Only these tasks are computed by the
+   current thread if they are still queued, so that the completion of a
+   task computed by a worker is noticed as soon as possible. The flags
+   of the task are not added to the ones of the current thread: this is
+   done by mpfr_task_join, which can then be called on the task. */
+int
+mpfr_task_wait_any (mpfr_task_t **t, int n)
+{
+  int i;
+
+  MPFR_MUTEX_LOCK (workers.mutex);
+  for (;;)
+    {
+      mpfr_task_t *u = NULL;
+
+      for (i = 0; i < n; i++)
+        if (t[i] != NULL)
+          {
+            if (t[i]->state == TASK_DONE)
+              {
+                MPFR_MUTEX_UNLOCK (workers.mutex);
+                return i;
+              }
+            if (u == NULL && t[i]->state == TASK_QUEUED)
+              u = t[i];
+          }
+      if (u != NULL)
+        {
+          dequeue (u);
+          run (u);
+        }
+      else
+        MPFR_COND_WAIT (workers.cond, workers.mutex);
+    }
+}
+
+/* Abandon t: cleanup (t->arg) is called when t is done, immediately if
+   it is done or still queued (it is then never computed), otherwise by
+   the thread computing it. */
+void
+mpfr_task_detach (mpfr_task_t *t, void (*cleanup) (void *))
+{
+  MPFR_MUTEX_LOCK (workers.mutex);
+  if (t->state == TASK_RUNNING)
+    {
+      t->cleanup = cleanup;
+      MPFR_MUTEX_UNLOCK (workers.mutex);
+      return;
+    }
+  if (t->state == TASK_QUEUED)
+    dequeue (t);
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+  cleanup (t->arg);
+}
+
+/* Terminate the workers. The queued tasks, if any, will be computed by
+   the threads joining them. */
+static void
+stop_workers (void)
+{
+  unsigned int i, n;
+  mpfr_thread_t *threads;
+  size_t size;
+
+  MPFR_MUTEX_LOCK (workers.mutex);
+  workers.stop = 1;
+  n = workers.nworkers;
+  threads = workers.threads;
+  size = workers.size;
+  MPFR_COND_BROADCAST (workers.cond);
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+
+  for (i = 0; i < n; i++)
+    MPFR_THREAD_JOIN (threads[i]);
+
+  MPFR_MUTEX_LOCK (workers.mutex);
+  workers.stop = 0;
+  workers.nworkers = 0;
+  workers.threads = NULL;
+  workers.size = 0;
+  MPFR_ATOMIC_STORE (__gmpfr_num_threads, 1);
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+
+  if (threads != NULL)
+    mpfr_free_func (threads, size);
+}
+
+int
+mpfr_set_num_threads (unsigned int n)
+{
+  unsigned int i;
+
+  if (n == 0)
+    n = 1;
+
+  MPFR_ONCE_CALL (workers.once, workers_init);
+  stop_workers ();
+  if (n == 1)
+    return 0;
+
+  MPFR_MUTEX_LOCK (workers.mutex);
+  workers.size = (n - 1) * sizeof (mpfr_thread_t);
+  workers.threads = (mpfr_thread_t *) mpfr_allocate_func (workers.size);
+  /* If not all the threads can be created, the other ones are kept. */
+  for (i = 0; i < n - 1; i++)
+    {
+      if (!MPFR_THREAD_CREATE (workers.threads[i], worker, NULL))
+        break;
+      workers.nworkers++;
+    }
+  MPFR_ATOMIC_STORE (__gmpfr_num_threads, workers.nworkers + 1);
+  MPFR_MUTEX_UNLOCK (workers.mutex);
+
+  return i < n - 1;
+}
+
+unsigned int
+mpfr_get_num_threads (void)
+{
+  return MPFR_ATOMIC_LOAD (__gmpfr_num_threads);
+}
+
+#else /* MPFR_WANT_PARALLEL */
+
+/* Without parallel support, the tasks are computed when they are forked,
+   and only one thread can be used. */
+
+void
+mpfr_task_fork (mpfr_task_t *t, void (*func) (void *), void *arg)
+{
+  func (arg);
+  t->state = TASK_DONE;
+}
+
+void
+mpfr_task_join (mpfr_task_t *t)
+{
+  MPFR_ASSERTD (t->state == TASK_DONE);
+  (void) t;
+}
+
+int
+mpfr_task_done_p (mpfr_task_t *t)
+{
+  return t->state == TASK_DONE;
+}
+
+int
+mpfr_task_wait_any (mpfr_task_t **t, int n)
+{
+  int i;
+
+  /* The tasks are done as soon as they are forked. */
+  for (i = 0; i < n; i++)
+    if (t[i] != NULL)
+      return i;
+  MPFR_RET_NEVER_GO_HERE ();
+}
+
+void
+mpfr_task_detach (mpfr_task_t *t, void (*cleanup) (void *))
+{
+  MPFR_ASSERTD (t->state == TASK_DONE);
+  cleanup (t->arg);
+}
+
+int
+mpfr_set_num_threads (unsigned int n)
+{
+  return n > 1;
+}
+
+unsigned int
+mpfr_get_num_threads (void)
+{
+  return 1;
+}
+
+#endif /* MPFR_WANT_PARALLEL */
@@ -20,34 +20,98 @@ along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
 #define MPFR_POOL_DONT_REDEFINE
+#define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
-#ifndef MPFR_POOL_MAX_SIZE
-# define MPFR_POOL_MAX_SIZE 32 /* maximal size (in limbs) for each entry */
-#endif
+/* The pool keeps at most MPFR_POOL_NENTRIES mpz_t (see mpfr-impl.h), whose
+   significands take at most MPFR_POOL_MAX_BYTES bytes in total. They are
+   sorted by size: class c contains the mpz_t having between 2^c and
+   2^(c+1)-1 allocated limbs. Thus mpfr_mpz_init2 can take an mpz_t that
+   is large enough (if any) from the smallest possible class, so that it
+   will not be reallocated. An mpz_t initialized by mpfr_mpz_init has no
+   expected size and will usually grow (e.g. in binary splitting), thus it
+   is taken from the largest class. */
 
 /* If the number of entries of the mpz_t pool is not zero */
 #if MPFR_POOL_NENTRIES
 
-/* Index in the stack table of mpz_t and stack table of mpz_t */
-static MPFR_THREAD_ATTR int n_alloc = 0;
-static MPFR_THREAD_ATTR __mpz_struct mpz_tab[MPFR_POOL_NENTRIES];
+/* The classes are represented by the bits of a limb. */
+#define MPFR_POOL_NCLASSES \
+  (GMP_NUMB_BITS < 32 ? GMP_NUMB_BITS : 32)
+
+/* Entries are numbered from 1, 0 meaning none (thus the initial state,
+   with all the fields to zero, is an empty pool). The stacks are linked
+   lists, where the link to the next entry is stored in the _mp_size field,
+   which is not used while the entry is in the pool. */
+struct mpfr_pool_s {
+  mp_limb_t mask;                   /* bit c set iff class c is not empty */
+  int head[MPFR_POOL_NCLASSES];     /* top of the stack of each class */
+  int free_head;                    /* stack of the unused entries ... */
+  int nused;                        /* ... and entries never used */
+  size_t bytes;                     /* total size of the significands */
+  unsigned long hits, misses, discards;
+  __mpz_struct tab[MPFR_POOL_NENTRIES];
+};
+
+#define NEXT(i) SIZ(&pool.tab[(i) - 1])
+
+static MPFR_THREAD_ATTR struct mpfr_pool_s pool;
+
+/* Maximal size of the significands in the pool, at most MPFR_POOL_MAX_BYTES
+   (see mpfr_pool_set_max_bytes). */
+static MPFR_THREAD_ATTR size_t pool_max_bytes = MPFR_POOL_MAX_BYTES;
+
+/* Set c to floor(log2(x)) for x > 0. */
+#ifdef MPFR_LONG_WITHIN_LIMB  /* count_leading_zeros is available */
+# define POOL_LOG2(c,x)                                 \
+  do {                                                  \
+    int _cnt;                                           \
+    count_leading_zeros (_cnt, (mp_limb_t) (x));        \
+    (c) = GMP_NUMB_BITS - 1 - _cnt;                     \
+  } while (0)
+#else
+# define POOL_LOG2(c,x)                                 \
+  do {                                                  \
+    mp_limb_t _x = (x);                                 \
+    for ((c) = 0; _x > 1; (c)++)                        \
+      _x >>= 1;                                         \
+  } while (0)
+#endif
+
+/* Take the top entry of the stack of class c (assumed to be non-empty)
+   and put it in z. */
+static void
+pool_get (mpz_ptr z, int c)
+{
+  int i = pool.head[c];
+
+  MPFR_ASSERTD (i > 0 && i <= MPFR_POOL_NENTRIES);
+  memcpy (z, &pool.tab[i - 1], sizeof (mpz_t));
+  SIZ(z) = 0;
+  pool.head[c] = NEXT (i);
+  if (pool.head[c] == 0)
+    pool.mask &= ~(MPFR_LIMB_ONE << c);
+  NEXT (i) = pool.free_head;
+  pool.free_head = i;
+  pool.bytes -= (size_t) ALLOC(z) * MPFR_BYTES_PER_MP_LIMB;
+  pool.hits++;
+}
 
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_mpz_init (mpz_ptr z)
 {
-  if (MPFR_LIKELY (n_alloc > 0))
+  if (MPFR_LIKELY (pool.mask != 0))
     {
-      /* Get a mpz_t from the MPFR stack of previously used mpz_t.
-         It reduces memory pressure, and it allows to reuse
-         a mpz_t that should be sufficiently big. */
-      MPFR_ASSERTD (n_alloc <= numberof (mpz_tab));
-      memcpy (z, &mpz_tab[--n_alloc], sizeof (mpz_t));
-      SIZ(z) = 0;
+      int c;
+
+      /* Get a mpz_t from the largest class. */
+      POOL_LOG2 (c, pool.mask);
+      pool_get (z, c);
     }
   else
     {
       /* Call the real GMP function */
+      pool.misses++;
       mpz_init (z);
     }
 }
@@ -55,62 +119,133 @@ mpfr_mpz_init (mpz_ptr z)
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_mpz_init2 (mpz_ptr z, mp_bitcnt_t n)
 {
-  /* The condition on n is used below as the argument n will be ignored if
-     the mpz_t is obtained from the MPFR stack of previously used mpz_t.
-     Said otherwise, it z is expected to have a large size at the end, then
-     it is better to allocate this size directly than to get a mpz_t of
-     small size, with possibly several realloc's on it. But if n satisfies
-     the condition and is larger than the stacked mpz_t, this may still
-     yield useless realloc's. This is not ideal. We might consider to use
-     mpz_init2 with the maximum size in mpfr_mpz_init to solve this issue. */
-  if (MPFR_LIKELY (n_alloc > 0 && n <= MPFR_POOL_MAX_SIZE * GMP_NUMB_BITS))
+  mp_bitcnt_t limbs = (n + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+  mp_limb_t m;
+  int c;
+
+  /* Only the classes c such that 2^c >= limbs are large enough. */
+  if (limbs <= 1)
+    m = pool.mask;
+  else if (limbs <= MPFR_LIMB_ONE << (MPFR_POOL_NCLASSES - 1))
+    {
+      POOL_LOG2 (c, limbs - 1);
+      m = pool.mask & ~((MPFR_LIMB_ONE << (c + 1)) - 1);
+    }
+  else
+    m = 0;
+
+  if (MPFR_LIKELY (m != 0))
     {
-      /* Get a mpz_t from the MPFR stack of previously used mpz_t.
-         It reduces memory pressure, and it allows to reuse
-         a mpz_t that should be sufficiently big. */
-      MPFR_ASSERTD (n_alloc <= numberof (mpz_tab));
-      memcpy (z, &mpz_tab[--n_alloc], sizeof (mpz_t));
-      SIZ(z) = 0;
+      /* Get a mpz_t from the smallest class, with m & -m being the
+         lowest bit set. */
+      POOL_LOG2 (c, m & - m);
+      pool_get (z, c);
     }
   else
     {
       /* Call the real GMP function */
+      pool.misses++;
       mpz_init2 (z, n);
     }
 }
 
-
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_mpz_clear (mpz_ptr z)
 {
-  /* We only put objects with at most MPFR_POOL_MAX_SIZE in the mpz_t pool,
-     to avoid it takes too much memory (and anyway the speedup is mainly
-     for small precision). */
-  if (MPFR_LIKELY (n_alloc < numberof (mpz_tab) &&
-                   ALLOC (z) <= MPFR_POOL_MAX_SIZE))
+  size_t bytes = (size_t) ALLOC(z) * MPFR_BYTES_PER_MP_LIMB;
+  int i;
+
+  /* An mpz_t without a significand (ALLOC = 0 since GMP 6.2) is not
+     kept since it costs nothing to create. */
+  if (MPFR_LIKELY (ALLOC(z) > 0 &&
+                   pool.bytes + bytes <= pool_max_bytes &&
+                   (pool.free_head != 0 ||
+                    pool.nused < MPFR_POOL_NENTRIES)))
     {
-      /* Push back the mpz_t inside the stack of the used mpz_t */
-      MPFR_ASSERTD (n_alloc >= 0);
-      memcpy (&mpz_tab[n_alloc++], z, sizeof (mpz_t));
+      int c;
+
+      if (pool.free_head != 0)
+        {
+          i = pool.free_head;
+          pool.free_head = NEXT (i);
+        }
+      else
+        i = ++pool.nused;
+      POOL_LOG2 (c, ALLOC(z));
+      MPFR_ASSERTD (c < MPFR_POOL_NCLASSES);
+      memcpy (&pool.tab[i - 1], z, sizeof (mpz_t));
+      NEXT (i) = pool.head[c];
+      pool.head[c] = i;
+      pool.mask |= MPFR_LIMB_ONE << c;
+      pool.bytes += bytes;
     }
   else
     {
       /* Call the real GMP function */
+      if (ALLOC(z) > 0)
+        pool.discards++;
       mpz_clear (z);
     }
 }
 
+/* Free the entries of the pool. */
+static void
+pool_clear (void)
+{
+  int c, i;
+
+  for (c = 0; c < MPFR_POOL_NCLASSES; c++)
+    {
+      for (i = pool.head[c]; i != 0; )
+        {
+          int j = NEXT (i);
+
+          NEXT (i) = 0;
+          mpz_clear (&pool.tab[i - 1]);
+          i = j;
+        }
+      pool.head[c] = 0;
+    }
+  pool.mask = 0;
+  pool.free_head = 0;
+  pool.nused = 0;
+  pool.bytes = 0;
+}
+
 #endif
 
 void
 mpfr_free_pool (void)
 {
 #if MPFR_POOL_NENTRIES
-  int i;
+  pool_clear ();
+#endif
+  /* the buffer of the arena is freed too */
+  mpfr_free_arena ();
+}
 
-  MPFR_ASSERTD (n_alloc >= 0 && n_alloc <= numberof (mpz_tab));
-  for (i = 0; i < n_alloc; i++)
-    mpz_clear (&mpz_tab[i]);
-  n_alloc = 0;
+void
+mpfr_pool_stats (mpfr_pool_stats_t *s)
+{
+#if MPFR_POOL_NENTRIES
+  s->hits = pool.hits;
+  s->misses = pool.misses;
+  s->discards = pool.discards;
+  s->bytes = pool.bytes;
+#else
+  s->hits = s->misses = s->discards = 0;
+  s->bytes = 0;
+#endif
+}
+
+/* Limit the size of the pool of the current thread to n bytes (see
+   budget.c), freeing its entries if need be. */
+void
+mpfr_pool_set_max_bytes (size_t n)
+{
+#if MPFR_POOL_NENTRIES
+  pool_max_bytes = MIN (n, MPFR_POOL_MAX_BYTES);
+  if (pool.bytes > pool_max_bytes)
+    pool_clear ();
 #endif
 }
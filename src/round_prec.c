@@ -73,17 +73,8 @@ mpfr_prec_round (mpfr_ptr x, mpfr_prec_t prec, mpfr_rnd_t rnd_mode)
       /* FIXME: Variable can't be created using custom allocation,
          MPFR_DECL_INIT or GROUP_ALLOC: How to detect? */
       ow = MPFR_GET_ALLOC_SIZE(x);
-      if (nw > ow)
-       {
-         mpfr_size_limb_t *tmpx;
-
-         /* Realloc significand */
-         tmpx = (mpfr_size_limb_t *) mpfr_reallocate_func
-           (MPFR_GET_REAL_PTR(x), MPFR_MALLOC_SIZE(ow), MPFR_MALLOC_SIZE(nw));
-         MPFR_SET_MANT_PTR(x, tmpx); /* mant ptr must be set
-                                        before alloc size */
-         MPFR_SET_ALLOC_SIZE(x, nw); /* new number of allocated limbs */
-       }
+      if (nw > ow) /* Realloc significand (an embedded one is copied) */
+        mpfr_realloc_mant (x, MPFR_GROW_ALLOC_SIZE (ow, nw));
     }
 
   if (MPFR_UNLIKELY( MPFR_IS_SINGULAR(x) ))
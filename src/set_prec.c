@@ -1,4 +1,5 @@
-/* mpfr_set_prec -- reset the precision of a floating-point number
+/* mpfr_set_prec, mpfr_reserve_prec -- reset the precision of a floating-point
+   number, or reserve memory for a larger one
 
 Copyright 1999, 2001-2002, 2004, 2006-2026 Free Software Foundation, Inc.
 Contributed by the Pascaline and Caramba projects, INRIA.
@@ -21,6 +22,28 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "mpfr-impl.h"
 
+/* Reallocate the significand of x to n limbs, n being larger than the
+   allocated size, keeping its contents. An embedded significand (see
+   small.c) is replaced by an allocated one. */
+void
+mpfr_realloc_mant (mpfr_ptr x, mp_size_t n)
+{
+  mp_size_t oldn = MPFR_GET_ALLOC_SIZE (x);
+  mpfr_size_limb_t *tmp;
+
+  MPFR_ASSERTD (n > oldn);
+  if (MPFR_UNLIKELY (MPFR_IS_EMBEDDED (x)))
+    {
+      tmp = (mpfr_size_limb_t *) mpfr_allocate_func (MPFR_MALLOC_SIZE(n));
+      MPN_COPY ((mp_limb_t *) (void *) (tmp + 1), MPFR_MANT(x), oldn);
+    }
+  else
+    tmp = (mpfr_size_limb_t *) mpfr_arena_reallocate
+      (MPFR_GET_REAL_PTR(x), MPFR_MALLOC_SIZE(oldn), MPFR_MALLOC_SIZE(n));
+  MPFR_SET_MANT_PTR(x, tmp); /* mant ptr must be set before alloc size */
+  MPFR_SET_ALLOC_SIZE(x, n);
+}
+
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_set_prec (mpfr_ptr x, mpfr_prec_t p)
 {
@@ -37,20 +60,35 @@ mpfr_set_prec (mpfr_ptr x, mpfr_prec_t p)
   /* Realloc only if the new size is greater than the old */
   xoldsize = MPFR_GET_ALLOC_SIZE (x);
   if (xsize > xoldsize)
-    {
-      mpfr_size_limb_t *tmp;
-
-      tmp = (mpfr_size_limb_t *) mpfr_reallocate_func
-        (MPFR_GET_REAL_PTR(x),
-         MPFR_MALLOC_SIZE(xoldsize),
-         MPFR_MALLOC_SIZE(xsize));
-      MPFR_SET_MANT_PTR(x, tmp);
-      MPFR_SET_ALLOC_SIZE(x, xsize);
-    }
+    mpfr_realloc_mant (x, MPFR_GROW_ALLOC_SIZE (xoldsize, xsize));
   MPFR_PREC (x) = p;
   MPFR_SET_NAN (x); /* initializes to NaN */
 }
 
+/* Make sure that the significand of x can hold p bits, without changing
+   its precision and its value. */
+void
+mpfr_reserve_prec (mpfr_ptr x, mpfr_prec_t p)
+{
+  mp_size_t n;
+
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  n = MPFR_PREC2LIMBS (p);
+  if (n > MPFR_GET_ALLOC_SIZE (x))
+    mpfr_realloc_mant (x, n);
+}
+
+/* Return the largest precision x can have without a reallocation. */
+mpfr_prec_t
+mpfr_get_reserved_prec (mpfr_srcptr x)
+{
+  mp_size_t n = MPFR_GET_ALLOC_SIZE (x);
+
+  return n <= MPFR_PREC_MAX / GMP_NUMB_BITS ?
+    (mpfr_prec_t) n * GMP_NUMB_BITS : MPFR_PREC_MAX;
+}
+
 #undef mpfr_get_prec
 mpfr_prec_t
 mpfr_get_prec (mpfr_srcptr x)
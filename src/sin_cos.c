@@ -458,30 +458,110 @@ sin_bs_aux (mpz_t Q0, mpz_t S0, mpz_t C0, mpz_srcptr p, mpfr_prec_t r,
   return m;
 }
 
+/* A chunk of the bits of x in sincos_aux: S/(2^l*Q) ~ sin(X) and
+   C/(2^l*Q) ~ cos(X), with X = y/2^(2sh-1) */
+typedef struct
+{
+  mpz_t Q, S, C, y;
+  mpfr_prec_t sh, prec;
+  unsigned long l;
+  mpfr_task_t task;
+} sincos_chunk;
+
+static void
+sincos_chunk_init (sincos_chunk *ch)
+{
+  mpz_init (ch->Q);
+  mpz_init (ch->S);
+  mpz_init (ch->C);
+  mpz_init (ch->y);
+}
+
+static void
+sincos_chunk_clear (sincos_chunk *ch)
+{
+  mpz_clear (ch->Q);
+  mpz_clear (ch->S);
+  mpz_clear (ch->C);
+  mpz_clear (ch->y);
+}
+
+static void
+sin_bs_task (void *arg)
+{
+  sincos_chunk *ch = (sincos_chunk *) arg;
+
+  ch->l = sin_bs_aux (ch->Q, ch->S, ch->C, ch->y, 2 * ch->sh - 1, ch->prec);
+  /* we now have |S/Q/2^l - sin(X)| <= 9*2^(prec)
+     and |C/Q/2^l - cos(X)| <= 6*2^(prec), with X=y/2^(2sh-1) */
+}
+
+/* Add the chunk ch to the part X of x already treated in sincos_aux:
+   S/(2^l*Q) ~ sin(X), C/(2^l*Q) ~ cos(X). The integers of ch are
+   destroyed. */
+static void
+sincos_combine (mpz_t Q, mpz_t S, mpz_t C, unsigned long *l,
+                sincos_chunk *ch, mpfr_prec_t prec_s)
+{
+  if (ch->sh == 1) /* S=0, C=1 */
+    {
+      *l = ch->l;
+      mpz_swap (Q, ch->Q);
+      mpz_swap (S, ch->S);
+      mpz_swap (C, ch->C);
+    }
+  else
+    {
+      /* s <- s*c2+c*s2, c <- c*c2-s*s2, using Karatsuba:
+         a = s+c, b = s2+c2, t = a*b, d = s*s2, e = c*c2,
+         s <- t - d - e, c <- e - d */
+      mpz_add (ch->y, S, C); /* a */
+      mpz_mul (C, C, ch->C); /* e */
+      mpz_add (ch->C, ch->C, ch->S); /* b */
+      mpz_mul (ch->S, S, ch->S); /* d */
+      mpz_mul (ch->y, ch->y, ch->C); /* a*b */
+      mpz_sub (S, ch->y, ch->S); /* t - d */
+      mpz_sub (S, S, C); /* t - d - e */
+      mpz_sub (C, C, ch->S); /* e - d */
+      mpz_mul (Q, Q, ch->Q);
+      /* after j loops, the error is <= (11j-2)*2^(prec_s) */
+      *l += ch->l;
+      /* reduce Q to prec_s bits */
+      *l += reduce (Q, Q, prec_s);
+      /* reduce S,C to prec_s bits, error <= 11*j*2^(prec_s) */
+      *l -= reduce2 (S, C, prec_s);
+    }
+}
+
 /* Put in s and c approximations of sin(x) and cos(x) respectively.
    Assumes 0 < x < Pi/4 and PREC(s) = PREC(c) >= 10.
    Return err such that the relative error is bounded by 2^err ulps.
+   In the parallel mode, the series of all the chunks of x are computed
+   in parallel, then combined in the same order as in the serial case,
+   so that the result is the same.
 */
 static int
 sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 {
   mpfr_prec_t prec_s, sh;
-  mpz_t Q, S, C, Q2, S2, C2, y;
+  mpz_t Q, S, C;
   mpfr_t x2;
-  unsigned long l, l2, j, err;
+  unsigned long l, j, err;
+  sincos_chunk chunks[sizeof (mpfr_prec_t) * CHAR_BIT], *ch;
+  int par, n, nch, i;
 
   MPFR_ASSERTD(MPFR_PREC(s) == MPFR_PREC(c));
 
   prec_s = MPFR_PREC(s);
+  par = MPFR_PARALLEL_P (prec_s, MPFR_PREC_PARALLEL_THRESHOLD);
 
   mpfr_init2 (x2, MPFR_PREC(x));
   mpz_init (Q);
   mpz_init (S);
   mpz_init (C);
-  mpz_init (Q2);
-  mpz_init (S2);
-  mpz_init (C2);
-  mpz_init (y);
+  sincos_chunk_init (chunks);
+  nch = 1; /* number of initialized chunks */
+  n = 0; /* number of chunks to combine in the parallel mode */
 
   mpfr_set (x2, x, MPFR_RNDN); /* exact */
   mpz_set_ui (Q, 1);
@@ -492,61 +572,59 @@ sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   /* Invariant: x = X + x2/2^(sh-1), where the part X was already treated,
      S/(2^l*Q) ~ sin(X), C/(2^l*Q) ~ cos(X), and x2/2^(sh-1) < Pi/4.
      'sh-1' is the number of already shifted bits in x2.
+     In the parallel mode, the part X is the one of the chunks 0 to n-1,
+     which are combined after the loop.
   */
 
   for (sh = 1, j = 0; mpfr_cmp_ui (x2, 0) != 0 && sh <= prec_s; sh <<= 1, j++)
     {
+      /* since sh <= prec_s, the number of chunks is less than the
+         number of bits of mpfr_prec_t */
+      MPFR_ASSERTD ((size_t) n < sizeof (mpfr_prec_t) * CHAR_BIT);
+      ch = chunks + n;
+      if (n == nch)
+        {
+          sincos_chunk_init (ch);
+          nch++;
+        }
+      ch->sh = sh;
       if (sh > prec_s / 2) /* sin(x) = x + O(x^3), cos(x) = 1 + O(x^2) */
         {
-          l2 = -mpfr_get_z_2exp (S2, x2); /* S2/2^l2 = x2 */
-          l2 += sh - 1;
-          mpz_set_ui (Q2, 1);
-          mpz_set_ui (C2, 1);
-          mpz_mul_2exp (C2, C2, l2);
+          ch->l = -mpfr_get_z_2exp (ch->S, x2); /* S/2^l = x2 */
+          ch->l += sh - 1;
+          mpz_set_ui (ch->Q, 1);
+          mpz_set_ui (ch->C, 1);
+          mpz_mul_2exp (ch->C, ch->C, ch->l);
           mpfr_set_ui (x2, 0, MPFR_RNDN);
         }
       else
         {
           /* y <- trunc(x2 * 2^sh) = trunc(x * 2^(2*sh-1)) */
           mpfr_mul_2ui (x2, x2, sh, MPFR_RNDN); /* exact */
-          mpfr_get_z (y, x2, MPFR_RNDZ); /* round toward zero: now
-                                           0 <= x2 < 2^sh, thus
-                                           0 <= x2/2^(sh-1) < 2^(1-sh) */
-          if (mpz_cmp_ui (y, 0) == 0)
+          mpfr_get_z (ch->y, x2, MPFR_RNDZ); /* round toward zero: now
+                                                0 <= x2 < 2^sh, thus
+                                                0 <= x2/2^(sh-1) < 2^(1-sh) */
+          if (mpz_cmp_ui (ch->y, 0) == 0)
             continue;
-          mpfr_sub_z (x2, x2, y, MPFR_RNDN); /* should be exact */
-          l2 = sin_bs_aux (Q2, S2, C2, y, 2 * sh - 1, prec_s);
-          /* we now have |S2/Q2/2^l2 - sin(X)| <= 9*2^(prec_s)
-             and |C2/Q2/2^l2 - cos(X)| <= 6*2^(prec_s), with X=y/2^(2sh-1) */
-        }
-      if (sh == 1) /* S=0, C=1 */
-        {
-          l = l2;
-          mpz_swap (Q, Q2);
-          mpz_swap (S, S2);
-          mpz_swap (C, C2);
+          mpfr_sub_z (x2, x2, ch->y, MPFR_RNDN); /* should be exact */
+          ch->prec = prec_s;
+          if (par)
+            mpfr_task_fork (&ch->task, sin_bs_task, ch);
+          else
+            sin_bs_task (ch);
         }
+      if (par)
+        n++;
       else
-        {
-          /* s <- s*c2+c*s2, c <- c*c2-s*s2, using Karatsuba:
-             a = s+c, b = s2+c2, t = a*b, d = s*s2, e = c*c2,
-             s <- t - d - e, c <- e - d */
-          mpz_add (y, S, C); /* a */
-          mpz_mul (C, C, C2); /* e */
-          mpz_add (C2, C2, S2); /* b */
-          mpz_mul (S2, S, S2); /* d */
-          mpz_mul (y, y, C2); /* a*b */
-          mpz_sub (S, y, S2); /* t - d */
-          mpz_sub (S, S, C); /* t - d - e */
-          mpz_sub (C, C, S2); /* e - d */
-          mpz_mul (Q, Q, Q2);
-          /* after j loops, the error is <= (11j-2)*2^(prec_s) */
-          l += l2;
-          /* reduce Q to prec_s bits */
-          l += reduce (Q, Q, prec_s);
-          /* reduce S,C to prec_s bits, error <= 11*j*2^(prec_s) */
-          l -= reduce2 (S, C, prec_s);
-        }
+        sincos_combine (Q, S, C, &l, ch, prec_s);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      ch = chunks + i;
+      if (ch->sh <= prec_s / 2)
+        mpfr_task_join (&ch->task);
+      sincos_combine (Q, S, C, &l, ch, prec_s);
     }
 
   j = 11 * j;
@@ -563,10 +641,8 @@ sincos_aux (mpfr_ptr s, mpfr_ptr c, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpz_clear (Q);
   mpz_clear (S);
   mpz_clear (C);
-  mpz_clear (Q2);
-  mpz_clear (S2);
-  mpz_clear (C2);
-  mpz_clear (y);
+  for (i = 0; i < nch; i++)
+    sincos_chunk_clear (chunks + i);
   mpfr_clear (x2);
   return err;
 }
@@ -0,0 +1,61 @@
+/* mpfr_small_init2 -- initialize a number with its significand embedded
+   in the structure
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_ARENA_DONT_REDEFINE
+#include "mpfr-impl.h"
+
+/* The significand of a mpfr_small_t is embedded in the structure when the
+   precision is at most MPFR_SMALL_PREC_MAX. It is preceded by the size
+   field, like a significand allocated by mpfr_init2, but this size is
+   stored as a negative number (see MPFR_IS_EMBEDDED), so that:
+   - mpfr_clear does not free it;
+   - mpfr_set_prec and mpfr_prec_round allocate a new significand (and
+     copy it for mpfr_prec_round) if the precision becomes too large, the
+     number then being an ordinary one;
+   - mpfr_swap exchanges the values instead of the pointers.
+   Otherwise, the number is just the _mpfr_x field of the structure, and
+   can be used with all the functions. */
+
+void
+mpfr_small_init2 (__mpfr_small_struct *x, mpfr_prec_t p)
+{
+  mpfr_ptr y = mpfr_small_ptr (x);
+
+  /* the size field must be just before the significand */
+  MPFR_STAT_STATIC_ASSERT (sizeof (x->_mpfr_h) == sizeof (mpfr_size_limb_t));
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  if (p > MPFR_SMALL_PREC_MAX)
+    {
+      mpfr_init2 (y, p);
+      return;
+    }
+
+  MPFR_ASSERTD ((mpfr_size_limb_t *) (void *) &x->_mpfr_h + 1
+                == (mpfr_size_limb_t *) (void *) x->_mpfr_d);
+  MPFR_PREC (y) = p;
+  MPFR_EXP (y) = MPFR_EXP_INVALID;
+  MPFR_SET_POS (y);
+  MPFR_SET_MANT_PTR (y, &x->_mpfr_h);
+  MPFR_SET_ALLOC_SIZE (y, - (mp_size_t) __MPFR_SMALL_LIMBS);
+  MPFR_SET_NAN (y);
+}
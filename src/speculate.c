@@ -0,0 +1,184 @@
+/* mpfr_set_speculation, mpfr_get_speculation -- speculative evaluation
+   at a higher precision in the parallel mode
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* The variables of an attempt may be freed by another thread, after the
+   return of mpfr_speculate, thus they are not temporary ones. */
+#define MPFR_ARENA_DONT_REDEFINE
+
+#include "mpfr-impl.h"
+
+#if defined(MPFR_WANT_PARALLEL)
+
+MPFR_THREAD_ATTR int __gmpfr_speculation = 0;
+
+/* An evaluation of f(x) in the precision of y, done by a task. The input
+   is copied, since the attempt may still be running after the return of
+   mpfr_speculate, and so is its data, freed by attempt_clear. */
+typedef struct
+{
+  mpfr_task_t task;
+  mpfr_unary_func_t f;
+  mpfr_t x, y;
+  mpfr_rnd_t rnd;
+  int inex;                     /* ternary value */
+} attempt;
+
+static attempt *
+attempt_new (mpfr_unary_func_t f, mpfr_srcptr x, mpfr_prec_t p,
+             mpfr_rnd_t rnd)
+{
+  attempt *a;
+
+  a = (attempt *) mpfr_allocate_func (sizeof (attempt));
+  a->f = f;
+  mpfr_init2 (a->x, MPFR_PREC (x));
+  mpfr_set (a->x, x, MPFR_RNDN);
+  mpfr_init2 (a->y, p);
+  a->rnd = rnd;
+  return a;
+}
+
+static void
+attempt_clear (void *arg)
+{
+  attempt *a = (attempt *) arg;
+
+  mpfr_clear (a->x);
+  mpfr_clear (a->y);
+  mpfr_free_func (a, sizeof (attempt));
+}
+
+static void
+attempt_task (void *arg)
+{
+  attempt *a = (attempt *) arg;
+  int s = __gmpfr_speculation;
+
+  /* An attempt is not itself speculative, even when it is computed by
+     a thread where the speculation is enabled. */
+  __gmpfr_speculation = 0;
+  a->inex = a->f (a->y, a->x, a->rnd);
+  __gmpfr_speculation = s;
+}
+
+/* Compute f(x) in y with the rounding mode rnd, where f is correctly
+   rounded, like mpfr_exp. Two attempts are raced: f(x) in the precision
+   p of y, and f(x) rounded to nearest in the precision q = p + one limb,
+   which is done when the Ziv loop of f in precision p would try its
+   second working precision. The second attempt wins if it finishes first
+   without any flag other than the inexact one and if it can be rounded
+   to p bits, which is the case unless f(x) is very close to a breakpoint
+   (it can then only be exactly representable in precision p if it is a
+   breakpoint, which mpfr_can_round excludes), so that the latency of the
+   hard-to-round cases is reduced. The losing attempt is abandoned. With
+   fewer than three threads, the attempts could not both be computed
+   while the current thread waits, and f is just called. */
+int
+mpfr_speculate (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd,
+                mpfr_unary_func_t f)
+{
+  mpfr_prec_t p = MPFR_PREC (y), q = p + GMP_NUMB_BITS;
+  attempt *a[2];
+  mpfr_task_t *t[2];
+  int i, inex;
+
+  if (mpfr_get_num_threads () < 3)
+    {
+      __gmpfr_speculation = 0;
+      inex = f (y, x, rnd);
+      __gmpfr_speculation = 1;
+      return inex;
+    }
+
+  a[0] = attempt_new (f, x, p, rnd);
+  a[1] = attempt_new (f, x, q, MPFR_RNDN);
+  for (i = 0; i < 2; i++)
+    {
+      mpfr_task_fork (&a[i]->task, attempt_task, a[i]);
+      t[i] = &a[i]->task;
+    }
+
+  for (;;)
+    {
+      i = mpfr_task_wait_any (t, 2);
+      if (i == 0)
+        break;
+      /* Here a[1] is done, and its flags are those of its task (the
+         error on f(x) is at most 1/2 ulp in precision q). */
+      if ((a[1]->task.ctx->_mpfr_flags & ~MPFR_FLAGS_INEXACT) == 0 &&
+          MPFR_CAN_ROUND (a[1]->y, q, p, rnd))
+        break;
+      attempt_clear (a[1]);
+      t[1] = NULL;
+    }
+
+  if (t[1 - i] != NULL)
+    mpfr_task_detach (t[1 - i], attempt_clear);
+  if (i == 0)
+    {
+      mpfr_task_join (t[0]);
+      mpfr_set (y, a[0]->y, MPFR_RNDN);  /* exact */
+      inex = a[0]->inex;
+    }
+  else
+    inex = mpfr_set (y, a[1]->y, rnd);
+  attempt_clear (a[i]);
+  return inex;
+}
+
+int
+mpfr_set_speculation (int s)
+{
+  __gmpfr_speculation = s != 0;
+  return 0;
+}
+
+int
+mpfr_get_speculation (void)
+{
+  return __gmpfr_speculation;
+}
+
+#else /* MPFR_WANT_PARALLEL */
+
+/* Without parallel support, the speculation cannot be enabled. */
+
+int
+mpfr_speculate (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd,
+                mpfr_unary_func_t f)
+{
+  return f (y, x, rnd);
+}
+
+int
+mpfr_set_speculation (int s)
+{
+  return s != 0;
+}
+
+int
+mpfr_get_speculation (void)
+{
+  return 0;
+}
+
+#endif /* MPFR_WANT_PARALLEL */
@@ -29,7 +29,7 @@ If not, see <https://www.gnu.org/licenses/>. */
    change here should be done also in mpfr_mul_1.
    Although this function works as soon as prec(a) < GMP_NUMB_BITS and
    prec(b) <= GMP_NUMB_BITS, we use it for prec(a)=prec(b) < GMP_NUMB_BITS. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sqr_1 (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode, mpfr_prec_t p)
 {
   mp_limb_t a0;
@@ -130,7 +130,7 @@ mpfr_sqr_1 (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode, mpfr_prec_t p)
 }
 
 /* special code for PREC(a) = GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sqr_1n (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode)
 {
   mp_limb_t a0;
@@ -229,7 +229,7 @@ mpfr_sqr_1n (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode)
    GMP_NUMB_BITS < prec(b) <= 2*GMP_NUMB_BITS.
    Note: this function was copied and optimized from mpfr_mul_2 in file mul.c,
    thus any change here should be done also in mpfr_mul_2, if applicable. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sqr_2 (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode, mpfr_prec_t p)
 {
   mp_limb_t h, l, u, v;
@@ -357,7 +357,7 @@ mpfr_sqr_2 (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode, mpfr_prec_t p)
 
 /* Special code for 2*GMP_NUMB_BITS < prec(a) < 3*GMP_NUMB_BITS and
    2*GMP_NUMB_BITS < prec(b) <= 3*GMP_NUMB_BITS. */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sqr_3 (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode, mpfr_prec_t p)
 {
   mp_limb_t a0, a1, a2, h, l;
@@ -508,10 +508,10 @@ mpfr_sqr (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode)
 {
   int cc, inexact;
   mpfr_exp_t ax;
-  mp_limb_t *tmp;
+  mp_limb_t *tmp, *bp;
   mp_limb_t b1;
   mpfr_prec_t aq, bq;
-  mp_size_t bn, tn;
+  mp_size_t bn, tn, z;
   MPFR_TMP_DECL(marker);
 
   MPFR_LOG_FUNC
@@ -568,8 +568,14 @@ mpfr_sqr (mpfr_ptr a, mpfr_srcptr b, mpfr_rnd_t rnd_mode)
   MPFR_TMP_MARK(marker);
   tmp = MPFR_TMP_LIMBS_ALLOC (2 * bn);
 
-  /* Multiplies the mantissa in temporary allocated space */
-  mpn_sqr (tmp, MPFR_MANT(b), bn);
+  /* Multiplies the mantissa in temporary allocated space, skipping the
+     trailing zero limbs of b (the loop ends since the most significant
+     limb is nonzero) */
+  bp = MPFR_MANT(b);
+  for (z = 0; bp[z] == 0; z++)
+    ;
+  MPN_ZERO (tmp, 2 * z);
+  mpn_sqr (tmp + 2 * z, bp + z, bn - z);
   b1 = tmp[2 * bn - 1];
 
   /* now tmp[0]..tmp[2*bn-1] contains the product of both mantissa,
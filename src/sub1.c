@@ -25,6 +25,34 @@ If not, see <https://www.gnu.org/licenses/>. */
    detection of reused arguments, do comparisons on the pointers to the
    significands instead of pointers to the MPFR numbers. */
 
+/* Return x, or if the least significant limb of x is zero, set t to an
+   alias of x without its trailing zero limbs, i.e. with a smaller
+   precision, and return t. This is not done if the significand of x is
+   ap, since the reuse of an argument is detected by comparing the
+   pointers (see above), nor for an UBF, whose exponent is not in the
+   mpfr_t structure. */
+static mpfr_srcptr
+strip_zero_limbs (mpfr_ptr t, mpfr_srcptr x, mp_limb_t *ap)
+{
+  mp_limb_t *xp = MPFR_MANT (x);
+  mp_size_t xn;
+
+  if (MPFR_LIKELY (xp[0] != 0) || xp == ap || MPFR_IS_UBF (x))
+    return x;
+
+  xn = MPFR_LIMB_SIZE (x);
+  do
+    {
+      xp++;
+      xn--;
+    }
+  while (*xp == 0);  /* ends since the most significant limb is nonzero */
+  MPFR_ALIAS (t, x, MPFR_SIGN (x), MPFR_EXP (x));
+  MPFR_PREC (t) = xn * GMP_NUMB_BITS;
+  MPFR_MANT (t) = xp;
+  return t;
+}
+
 /* compute sign(b) * (|b| - |c|), with |b| > |c|, diff_exp = EXP(b) - EXP(c)
    Returns 0 iff result is exact,
    a negative value when the result is less than the exact value,
@@ -45,6 +73,7 @@ mpfr_sub1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
   int cmp_low = 0; /* used for rounding to nearest: 0 if low(b) = low(c),
                       negative if low(b) < low(c), positive if low(b) > low(c) */
   int sh, k;
+  mpfr_t b_tmp, c_tmp;
   MPFR_TMP_DECL(marker);
 
   MPFR_LOG_FUNC
@@ -61,6 +90,12 @@ mpfr_sub1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
   (void) MPFR_GET_PREC (b);
   (void) MPFR_GET_PREC (c);
 
+  /* The trailing zero limbs of b and c (e.g. for an integer or a dyadic
+     number with few bits in a large precision) need not be shifted nor
+     subtracted below. */
+  b = strip_zero_limbs (b_tmp, b, ap);
+  c = strip_zero_limbs (c_tmp, c, ap);
+
   sign = mpfr_cmp2 (b, c, &cancel);
 
   if (MPFR_UNLIKELY(sign == 0))
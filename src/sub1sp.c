@@ -136,7 +136,7 @@ int mpfr_sub1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 #else
 
 /* special code for p < GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sub1sp1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
               mpfr_prec_t p)
 {
@@ -322,7 +322,7 @@ mpfr_sub1sp1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
 #endif /* MPFR_WANT_PROVEN_CODE */
 
 /* special code for p = GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sub1sp1n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mpfr_exp_t bx = MPFR_GET_EXP (b);
@@ -510,7 +510,7 @@ mpfr_sub1sp1n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 }
 
 /* special code for GMP_NUMB_BITS < p < 2*GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
               mpfr_prec_t p)
 {
@@ -772,7 +772,7 @@ mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
 }
 
 /* special code for p = 2*GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mpfr_exp_t bx = MPFR_GET_EXP (b);
@@ -1053,7 +1053,7 @@ mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 }
 
 /* special code for 2*GMP_NUMB_BITS < p < 3*GMP_NUMB_BITS */
-static int
+static MPFR_TARGET_CLONES_ATTR int
 mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
               mpfr_prec_t p)
 {
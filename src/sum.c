@@ -95,6 +95,304 @@ int __gmpfr_cov_sum_tmd[MPFR_RND_MAX][2][2][3][2][2] = { 0 };
     }                                           \
   while (0)
 
+/* Accumulate the inputs x[0] to x[n-1] into (wp,ws) for the block
+ * [minexp,maxexp[, as in the loop of sum_raw (Steps 1 to 5), and return
+ * the corresponding maxexp2 (MPFR_EXP_MIN if there are no bits after
+ * minexp). The accumulation is done modulo 2^(ws*GMP_NUMB_BITS) and
+ * the contribution of each input does not depend on the contents of the
+ * accumulator, so that the inputs can be split into several parts, each
+ * one accumulated separately, the accumulators being added at the end:
+ * this is done in the parallel mode (see sum_raw_parallel).
+ */
+static mpfr_exp_t
+sum_raw_block (mp_limb_t *wp, mp_size_t ws, const mpfr_ptr *x,
+               unsigned long n, mpfr_exp_t minexp, mpfr_exp_t maxexp,
+               mp_limb_t *tp, mp_size_t ts)
+{
+  mpfr_exp_t maxexp2 = MPFR_EXP_MIN;
+  unsigned long i;
+
+  for (i = 0; i < n; i++)
+    if (! MPFR_IS_SINGULAR (x[i]))  /* Step 1 (see sum_raw in sum.txt) */
+      {
+        mp_limb_t *dp, *vp;
+        mp_size_t ds, vs, vds;
+        mpfr_exp_t xe, vd;
+        mpfr_prec_t xq;
+        int tr;
+
+        xe = MPFR_GET_EXP (x[i]);
+        xq = MPFR_GET_PREC (x[i]);
+
+        vp = MPFR_MANT (x[i]);
+        vs = MPFR_PREC2LIMBS (xq);
+        vd = xe - vs * GMP_NUMB_BITS - minexp;
+        /* vd is the exponent of the least significant represented bit of
+           x[i] (including the trailing bits, whose value is 0) minus the
+           exponent of the least significant bit of the accumulator. To
+           make the code simpler, we won't try to filter out the trailing
+           bits of x[i]. */
+
+        /* Steps 2, 3, 4 (see sum_raw in sum.txt) */
+
+        if (vd < 0)
+          {
+            /* This covers the following cases:
+             *     [-+- accumulator ---]
+             *   [---|----- x[i] ------|--]
+             *       |   [----- x[i] --|--]
+             *       |                 |[----- x[i] -----]
+             *       |                 |    [----- x[i] -----]
+             *     maxexp           minexp
+             */
+
+            /* Step 2 for subcase vd < 0 */
+
+            if (xe <= minexp)
+              {
+                /* x[i] is entirely after the LSB of the accumulator,
+                   so that it will be ignored at this iteration. */
+                if (xe > maxexp2)
+                  {
+                    maxexp2 = xe;
+                    /* And since the exponent of x[i] is valid... */
+                    MPFR_ASSERTD (maxexp2 >= MPFR_EMIN_MIN);
+                  }
+                continue;
+              }
+
+            /* Step 3 for subcase vd < 0 */
+
+            /* If some significant bits of x[i] are after the LSB of the
+               accumulator, then maxexp2 will necessarily be minexp. */
+            if (MPFR_LIKELY (xe - xq < minexp))
+              maxexp2 = minexp;
+
+            /* Step 4 for subcase vd < 0 */
+
+            /* We need to ignore the least |vd| significant bits of x[i].
+               First, let's ignore the least vds = |vd| / GMP_NUMB_BITS
+               limbs. */
+            vd = - vd;
+            vds = vd / GMP_NUMB_BITS;
+            vs -= vds;
+            MPFR_ASSERTD (vs > 0);  /* see xe <= minexp test above */
+            vp += vds;
+            vd -= vds * GMP_NUMB_BITS;
+            MPFR_ASSERTD (vd >= 0 && vd < GMP_NUMB_BITS);
+
+            if (xe > maxexp)
+              {
+                vs -= (xe - maxexp) / GMP_NUMB_BITS;
+                MPFR_ASSERTD (vs > 0);
+                tr = (xe - maxexp) % GMP_NUMB_BITS;
+              }
+            else
+              tr = 0;
+
+            if (vd != 0)
+              {
+                MPFR_ASSERTD (vs <= ts);
+                mpn_rshift (tp, vp, vs, vd);
+                vp = tp;
+                tr += vd;
+                if (tr >= GMP_NUMB_BITS)
+                  {
+                    vs--;
+                    tr -= GMP_NUMB_BITS;
+                  }
+                MPFR_ASSERTD (vs >= 1);
+                MPFR_ASSERTD (tr >= 0 && tr < GMP_NUMB_BITS);
+                if (tr != 0)
+                  {
+                    tp[vs-1] &= MPFR_LIMB_MASK (GMP_NUMB_BITS - tr);
+                    tr = 0;
+                  }
+                /* Truncation has now been taken into account. */
+                MPFR_ASSERTD (tr == 0);
+              }
+
+            dp = wp;
+            ds = ws;
+          }
+        else  /* vd >= 0 */
+          {
+            /* This covers the following cases:
+             *               [-+- accumulator ---]
+             *   [- x[i] -]    |                 |
+             *             [---|-- x[i] ------]  |
+             *          [------|-- x[i] ---------]
+             *                 |   [- x[i] -]    |
+             *               maxexp           minexp
+             */
+
+            /* Steps 2 and 3 for subcase vd >= 0 */
+
+            MPFR_ASSERTD (xe - xq >= minexp);  /* see definition of vd */
+
+            /* Step 4 for subcase vd >= 0 */
+
+            /* We need to ignore the least vd significant bits
+               of the accumulator. First, let's ignore the least
+               vds = vd / GMP_NUMB_BITS limbs. -> (dp,ds) */
+            vds = vd / GMP_NUMB_BITS;
+            ds = ws - vds;
+            if (ds <= 0)
+              continue;
+            dp = wp + vds;
+            vd -= vds * GMP_NUMB_BITS;
+            MPFR_ASSERTD (vd >= 0 && vd < GMP_NUMB_BITS);
+
+            /* The low part of x[i] (to be determined) will have to be
+               shifted vd bits to the left if vd != 0. */
+
+            if (xe > maxexp)
+              {
+                vs -= (xe - maxexp) / GMP_NUMB_BITS;
+                if (vs <= 0)
+                  continue;
+                tr = (xe - maxexp) % GMP_NUMB_BITS;
+              }
+            else
+              tr = 0;
+
+            MPFR_ASSERTD (tr >= 0 && tr < GMP_NUMB_BITS && vs > 0);
+
+            /* We need to consider the least significant vs limbs of x[i]
+               except the most significant tr bits. */
+
+            if (vd != 0)
+              {
+                mp_limb_t carry;
+
+                MPFR_ASSERTD (vs <= ts);
+                carry = mpn_lshift (tp, vp, vs, vd);
+                tr -= vd;
+                if (tr < 0)
+                  {
+                    tr += GMP_NUMB_BITS;
+                    MPFR_ASSERTD (vs + 1 <= ts);
+                    tp[vs++] = carry;
+                  }
+                MPFR_ASSERTD (tr >= 0 && tr < GMP_NUMB_BITS);
+                vp = tp;
+              }
+          }  /* vd >= 0 */
+
+        MPFR_ASSERTD (vs > 0 && vs <= ds);
+
+        /* We can't truncate the most significant limb of the input
+           (in case it hasn't been shifted to the temporary area).
+           So, let's ignore it now. It will be taken into account
+           via carry propagation after the addition. */
+        if (tr != 0)
+          vs--;
+
+        /* Step 5 (see sum_raw in sum.txt) */
+
+        if (MPFR_IS_POS (x[i]))
+          {
+            mp_limb_t carry;
+
+            carry = vs > 0 ? mpn_add_n (dp, dp, vp, vs) : 0;
+            MPFR_ASSERTD (carry <= 1);
+            if (tr != 0)
+              carry += vp[vs] & MPFR_LIMB_MASK (GMP_NUMB_BITS - tr);
+            if (ds > vs)
+              mpn_add_1 (dp + vs, dp + vs, ds - vs, carry);
+          }
+        else
+          {
+            mp_limb_t borrow;
+
+            borrow = vs > 0 ? mpn_sub_n (dp, dp, vp, vs) : 0;
+            MPFR_ASSERTD (borrow <= 1);
+            if (tr != 0)
+              borrow += vp[vs] & MPFR_LIMB_MASK (GMP_NUMB_BITS - tr);
+            if (ds > vs)
+              mpn_sub_1 (dp + vs, dp + vs, ds - vs, borrow);
+          }
+      }
+
+  return maxexp2;
+}
+
+/* Arguments of sum_raw_block for a part of the inputs */
+typedef struct
+{
+  mp_limb_t *wp, *tp;
+  mp_size_t ws, ts;
+  const mpfr_ptr *x;
+  unsigned long n;
+  mpfr_exp_t minexp, maxexp, maxexp2;
+  mpfr_task_t task;
+} sum_raw_part;
+
+static void
+sum_raw_task (void *arg)
+{
+  sum_raw_part *p = (sum_raw_part *) arg;
+
+  p->maxexp2 = sum_raw_block (p->wp, p->ws, p->x, p->n, p->minexp,
+                              p->maxexp, p->tp, p->ts);
+}
+
+/* Same as sum_raw_block, but with the inputs split into as many parts as
+   threads, the first part being accumulated directly into (wp,ws) by the
+   current thread and the other ones into zeroed accumulators by the other
+   threads. As these accumulators are then added to (wp,ws) modulo
+   2^(ws*GMP_NUMB_BITS), the result is exactly the same as with
+   sum_raw_block, whatever the number of parts. */
+static mpfr_exp_t
+sum_raw_parallel (mp_limb_t *wp, mp_size_t ws, const mpfr_ptr *x,
+                  unsigned long n, mpfr_exp_t minexp, mpfr_exp_t maxexp,
+                  mp_limb_t *tp, mp_size_t ts)
+{
+  sum_raw_part *parts;
+  unsigned long np, k, n0;
+  mpfr_exp_t maxexp2;
+  MPFR_TMP_DECL (marker);
+
+  /* The number of threads may have been changed in the meantime. */
+  np = mpfr_get_num_threads ();
+  if (np > n)
+    np = n;
+  n0 = n / np;
+
+  MPFR_TMP_MARK (marker);
+  parts = (sum_raw_part *) MPFR_TMP_ALLOC (np * sizeof (sum_raw_part));
+  for (k = 1; k < np; k++)
+    {
+      sum_raw_part *p = parts + k;
+
+      p->wp = MPFR_TMP_LIMBS_ALLOC (ws + ts);
+      p->tp = p->wp + ws;
+      MPN_ZERO (p->wp, ws);
+      p->ws = ws;
+      p->ts = ts;
+      p->x = x + k * n0;
+      p->n = k < np - 1 ? n0 : n - k * n0;
+      p->minexp = minexp;
+      p->maxexp = maxexp;
+      mpfr_task_fork (&p->task, sum_raw_task, p);
+    }
+
+  maxexp2 = sum_raw_block (wp, ws, x, n0, minexp, maxexp, tp, ts);
+
+  for (k = 1; k < np; k++)
+    {
+      sum_raw_part *p = parts + k;
+
+      mpfr_task_join (&p->task);
+      mpn_add_n (wp, wp, p->wp, ws);  /* modulo 2^(ws*GMP_NUMB_BITS) */
+      if (p->maxexp2 > maxexp2)
+        maxexp2 = p->maxexp2;
+    }
+
+  MPFR_TMP_FREE (marker);
+  return maxexp2;
+}
+
 /* Function sum_raw
  * ================
  *
@@ -170,8 +468,7 @@ sum_raw (mp_limb_t *wp, mp_size_t ws, mpfr_prec_t wq, const mpfr_ptr *x,
 
   while (1)
     {
-      mpfr_exp_t maxexp2 = MPFR_EXP_MIN;
-      unsigned long i;
+      mpfr_exp_t maxexp2;
 
       MPFR_LOG_MSG (("sum_raw loop: "
                      "maxexp=%" MPFR_EXP_FSPEC "d "
@@ -180,207 +477,10 @@ sum_raw (mp_limb_t *wp, mp_size_t ws, mpfr_prec_t wq, const mpfr_ptr *x,
 
       MPFR_ASSERTD (maxexp > minexp);
 
-      for (i = 0; i < n; i++)
-        if (! MPFR_IS_SINGULAR (x[i]))  /* Step 1 (see sum_raw in sum.txt) */
-          {
-            mp_limb_t *dp, *vp;
-            mp_size_t ds, vs, vds;
-            mpfr_exp_t xe, vd;
-            mpfr_prec_t xq;
-            int tr;
-
-            xe = MPFR_GET_EXP (x[i]);
-            xq = MPFR_GET_PREC (x[i]);
-
-            vp = MPFR_MANT (x[i]);
-            vs = MPFR_PREC2LIMBS (xq);
-            vd = xe - vs * GMP_NUMB_BITS - minexp;
-            /* vd is the exponent of the least significant represented bit of
-               x[i] (including the trailing bits, whose value is 0) minus the
-               exponent of the least significant bit of the accumulator. To
-               make the code simpler, we won't try to filter out the trailing
-               bits of x[i]. */
-
-            /* Steps 2, 3, 4 (see sum_raw in sum.txt) */
-
-            if (vd < 0)
-              {
-                /* This covers the following cases:
-                 *     [-+- accumulator ---]
-                 *   [---|----- x[i] ------|--]
-                 *       |   [----- x[i] --|--]
-                 *       |                 |[----- x[i] -----]
-                 *       |                 |    [----- x[i] -----]
-                 *     maxexp           minexp
-                 */
-
-                /* Step 2 for subcase vd < 0 */
-
-                if (xe <= minexp)
-                  {
-                    /* x[i] is entirely after the LSB of the accumulator,
-                       so that it will be ignored at this iteration. */
-                    if (xe > maxexp2)
-                      {
-                        maxexp2 = xe;
-                        /* And since the exponent of x[i] is valid... */
-                        MPFR_ASSERTD (maxexp2 >= MPFR_EMIN_MIN);
-                      }
-                    continue;
-                  }
-
-                /* Step 3 for subcase vd < 0 */
-
-                /* If some significant bits of x[i] are after the LSB of the
-                   accumulator, then maxexp2 will necessarily be minexp. */
-                if (MPFR_LIKELY (xe - xq < minexp))
-                  maxexp2 = minexp;
-
-                /* Step 4 for subcase vd < 0 */
-
-                /* We need to ignore the least |vd| significant bits of x[i].
-                   First, let's ignore the least vds = |vd| / GMP_NUMB_BITS
-                   limbs. */
-                vd = - vd;
-                vds = vd / GMP_NUMB_BITS;
-                vs -= vds;
-                MPFR_ASSERTD (vs > 0);  /* see xe <= minexp test above */
-                vp += vds;
-                vd -= vds * GMP_NUMB_BITS;
-                MPFR_ASSERTD (vd >= 0 && vd < GMP_NUMB_BITS);
-
-                if (xe > maxexp)
-                  {
-                    vs -= (xe - maxexp) / GMP_NUMB_BITS;
-                    MPFR_ASSERTD (vs > 0);
-                    tr = (xe - maxexp) % GMP_NUMB_BITS;
-                  }
-                else
-                  tr = 0;
-
-                if (vd != 0)
-                  {
-                    MPFR_ASSERTD (vs <= ts);
-                    mpn_rshift (tp, vp, vs, vd);
-                    vp = tp;
-                    tr += vd;
-                    if (tr >= GMP_NUMB_BITS)
-                      {
-                        vs--;
-                        tr -= GMP_NUMB_BITS;
-                      }
-                    MPFR_ASSERTD (vs >= 1);
-                    MPFR_ASSERTD (tr >= 0 && tr < GMP_NUMB_BITS);
-                    if (tr != 0)
-                      {
-                        tp[vs-1] &= MPFR_LIMB_MASK (GMP_NUMB_BITS - tr);
-                        tr = 0;
-                      }
-                    /* Truncation has now been taken into account. */
-                    MPFR_ASSERTD (tr == 0);
-                  }
-
-                dp = wp;
-                ds = ws;
-              }
-            else  /* vd >= 0 */
-              {
-                /* This covers the following cases:
-                 *               [-+- accumulator ---]
-                 *   [- x[i] -]    |                 |
-                 *             [---|-- x[i] ------]  |
-                 *          [------|-- x[i] ---------]
-                 *                 |   [- x[i] -]    |
-                 *               maxexp           minexp
-                 */
-
-                /* Steps 2 and 3 for subcase vd >= 0 */
-
-                MPFR_ASSERTD (xe - xq >= minexp);  /* see definition of vd */
-
-                /* Step 4 for subcase vd >= 0 */
-
-                /* We need to ignore the least vd significant bits
-                   of the accumulator. First, let's ignore the least
-                   vds = vd / GMP_NUMB_BITS limbs. -> (dp,ds) */
-                vds = vd / GMP_NUMB_BITS;
-                ds = ws - vds;
-                if (ds <= 0)
-                  continue;
-                dp = wp + vds;
-                vd -= vds * GMP_NUMB_BITS;
-                MPFR_ASSERTD (vd >= 0 && vd < GMP_NUMB_BITS);
-
-                /* The low part of x[i] (to be determined) will have to be
-                   shifted vd bits to the left if vd != 0. */
-
-                if (xe > maxexp)
-                  {
-                    vs -= (xe - maxexp) / GMP_NUMB_BITS;
-                    if (vs <= 0)
-                      continue;
-                    tr = (xe - maxexp) % GMP_NUMB_BITS;
-                  }
-                else
-                  tr = 0;
-
-                MPFR_ASSERTD (tr >= 0 && tr < GMP_NUMB_BITS && vs > 0);
-
-                /* We need to consider the least significant vs limbs of x[i]
-                   except the most significant tr bits. */
-
-                if (vd != 0)
-                  {
-                    mp_limb_t carry;
-
-                    MPFR_ASSERTD (vs <= ts);
-                    carry = mpn_lshift (tp, vp, vs, vd);
-                    tr -= vd;
-                    if (tr < 0)
-                      {
-                        tr += GMP_NUMB_BITS;
-                        MPFR_ASSERTD (vs + 1 <= ts);
-                        tp[vs++] = carry;
-                      }
-                    MPFR_ASSERTD (tr >= 0 && tr < GMP_NUMB_BITS);
-                    vp = tp;
-                  }
-              }  /* vd >= 0 */
-
-            MPFR_ASSERTD (vs > 0 && vs <= ds);
-
-            /* We can't truncate the most significant limb of the input
-               (in case it hasn't been shifted to the temporary area).
-               So, let's ignore it now. It will be taken into account
-               via carry propagation after the addition. */
-            if (tr != 0)
-              vs--;
-
-            /* Step 5 (see sum_raw in sum.txt) */
-
-            if (MPFR_IS_POS (x[i]))
-              {
-                mp_limb_t carry;
-
-                carry = vs > 0 ? mpn_add_n (dp, dp, vp, vs) : 0;
-                MPFR_ASSERTD (carry <= 1);
-                if (tr != 0)
-                  carry += vp[vs] & MPFR_LIMB_MASK (GMP_NUMB_BITS - tr);
-                if (ds > vs)
-                  mpn_add_1 (dp + vs, dp + vs, ds - vs, carry);
-              }
-            else
-              {
-                mp_limb_t borrow;
-
-                borrow = vs > 0 ? mpn_sub_n (dp, dp, vp, vs) : 0;
-                MPFR_ASSERTD (borrow <= 1);
-                if (tr != 0)
-                  borrow += vp[vs] & MPFR_LIMB_MASK (GMP_NUMB_BITS - tr);
-                if (ds > vs)
-                  mpn_sub_1 (dp + vs, dp + vs, ds - vs, borrow);
-              }
-          }
+      if (MPFR_PARALLEL_P (n, MPFR_SUM_PARALLEL_THRESHOLD))
+        maxexp2 = sum_raw_parallel (wp, ws, x, n, minexp, maxexp, tp, ts);
+      else
+        maxexp2 = sum_raw_block (wp, ws, x, n, minexp, maxexp, tp, ts);
 
       {
         mpfr_prec_t cancel;  /* number of cancelled bits */
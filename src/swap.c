@@ -21,6 +21,64 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "mpfr-impl.h"
 
+/* An embedded significand (see small.c) must stay in its structure, thus
+   the values are copied. Here u has an embedded significand. */
+static void
+swap_embedded (mpfr_ptr u, mpfr_ptr v)
+{
+  mp_limb_t t[__MPFR_SMALL_LIMBS];
+  mpfr_prec_t pu;
+  mpfr_sign_t su;
+  mpfr_exp_t eu;
+  mp_size_t nu, nv;
+
+  if (u == v)
+    return;
+  pu = MPFR_PREC(u);
+  su = MPFR_SIGN(u);
+  eu = MPFR_EXP(u);
+  nu = MPFR_PREC2LIMBS (pu);
+  nv = MPFR_PREC2LIMBS (MPFR_PREC(v));
+  MPFR_ASSERTD (nu <= __MPFR_SMALL_LIMBS);
+  MPN_COPY (t, MPFR_MANT(u), nu);
+
+  /* u = v */
+  if (nv <= __MPFR_SMALL_LIMBS)
+    {
+      MPN_COPY (MPFR_MANT(u), MPFR_MANT(v), nv);
+      if (MPFR_GET_ALLOC_SIZE(v) < nu)
+        {
+          /* v cannot be embedded, since nu <= __MPFR_SMALL_LIMBS */
+          mpfr_size_limb_t *tmp;
+
+          tmp = (mpfr_size_limb_t *) mpfr_arena_reallocate
+            (MPFR_GET_REAL_PTR(v), MPFR_MALLOC_SIZE(MPFR_GET_ALLOC_SIZE(v)),
+             MPFR_MALLOC_SIZE(nu));
+          MPFR_SET_MANT_PTR(v, tmp);
+          MPFR_SET_ALLOC_SIZE(v, nu);
+        }
+    }
+  else
+    {
+      /* v is not embedded: u takes its significand, and v gets a new one */
+      mpfr_size_limb_t *tmp;
+
+      MPFR_MANT(u) = MPFR_MANT(v);
+      tmp = (mpfr_size_limb_t *) mpfr_allocate_func (MPFR_MALLOC_SIZE(nu));
+      MPFR_SET_MANT_PTR(v, tmp);
+      MPFR_SET_ALLOC_SIZE(v, nu);
+    }
+  MPFR_PREC(u) = MPFR_PREC(v);
+  MPFR_SIGN(u) = MPFR_SIGN(v);
+  MPFR_EXP(u) = MPFR_EXP(v);
+
+  /* v = old u */
+  MPN_COPY (MPFR_MANT(v), t, nu);
+  MPFR_PREC(v) = pu;
+  MPFR_SIGN(v) = su;
+  MPFR_EXP(v) = eu;
+}
+
 /* Using memcpy is a few slower than swapping by hand. */
 
 void
@@ -31,6 +89,21 @@ mpfr_swap (mpfr_ptr u, mpfr_ptr v)
   mpfr_exp_t e1, e2;
   mp_limb_t *m1, *m2;
 
+  /* The size field is read only if the significand may be embedded, since
+     it does not exist for some temporary variables (MPFR_TMP_INIT). */
+  if (MPFR_UNLIKELY (MPFR_MANT(u) == MPFR_SMALL_LIMBS (u)
+                     && MPFR_IS_EMBEDDED (u)))
+    {
+      swap_embedded (u, v);
+      return;
+    }
+  if (MPFR_UNLIKELY (MPFR_MANT(v) == MPFR_SMALL_LIMBS (v)
+                     && MPFR_IS_EMBEDDED (v)))
+    {
+      swap_embedded (v, u);
+      return;
+    }
+
   p1 = MPFR_PREC(u);
   p2 = MPFR_PREC(v);
   MPFR_PREC(v) = p1;
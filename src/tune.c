@@ -0,0 +1,366 @@
+/* mpfr_tune_get, mpfr_tune_set, mpfr_tune_reset, mpfr_tune_load,
+   mpfr_tune_save -- run-time thresholds
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* We need the compile-time values of the thresholds from mparam.h,
+   not the MPFR_*_THRESHOLD macros expanding to the run-time values. */
+#define MPFR_TUNE_DEFAULTS
+#include "mpfr-impl.h"
+
+/* The run-time values, initialized from mparam.h. They are global, not
+   thread-local: the thresholds depend on the processor, not on the thread.
+   Note: the tables used by mulders.c must not be defined in mulders.c,
+   since tune/tuneup.c includes mulders.c and links with the static MPFR
+   library (this would give multiply defined symbols). */
+
+struct __gmpfr_tune_s __gmpfr_tune = {
+  MPFR_MUL_THRESHOLD, MPFR_SQR_THRESHOLD, MPFR_DIV_THRESHOLD,
+  MPFR_EXP_2_THRESHOLD, MPFR_EXP_THRESHOLD, MPFR_SINCOS_THRESHOLD,
+  MPFR_AI_THRESHOLD1, MPFR_AI_THRESHOLD2, MPFR_AI_THRESHOLD3
+};
+
+short __gmpfr_mulhigh_ktab[] = {MPFR_MULHIGH_TAB};
+short __gmpfr_sqrhigh_ktab[] = {MPFR_SQRHIGH_TAB};
+short __gmpfr_divhigh_ktab[] = {MPFR_DIVHIGH_TAB};
+
+static const short mulhigh_default[] = {MPFR_MULHIGH_TAB};
+static const short sqrhigh_default[] = {MPFR_SQRHIGH_TAB};
+static const short divhigh_default[] = {MPFR_DIVHIGH_TAB};
+
+const mp_size_t __gmpfr_mulhigh_ktab_size =
+  numberof_const (__gmpfr_mulhigh_ktab);
+const mp_size_t __gmpfr_sqrhigh_ktab_size =
+  numberof_const (__gmpfr_sqrhigh_ktab);
+const mp_size_t __gmpfr_divhigh_ktab_size =
+  numberof_const (__gmpfr_divhigh_ktab);
+
+/* Names used in the tuning files, in the order of mpfr_tune_t. */
+static const char *const tune_names[MPFR_TUNE_MAX] = {
+  "mul_threshold", "sqr_threshold", "div_threshold",
+  "exp_2_threshold", "exp_threshold", "sincos_threshold",
+  "ai_threshold1", "ai_threshold2", "ai_threshold3",
+  "mulhigh_tab", "sqrhigh_tab", "divhigh_tab"
+};
+
+#define TUNE_IS_TAB(p) ((p) >= MPFR_TUNE_MULHIGH_TAB)
+
+/* Return the table associated with p (assumed to be a table parameter),
+   and set *size to its number of entries. */
+static short *
+tune_tab (mpfr_tune_t p, mp_size_t *size)
+{
+  MPFR_ASSERTD (TUNE_IS_TAB (p) && p < MPFR_TUNE_MAX);
+  if (p == MPFR_TUNE_MULHIGH_TAB)
+    {
+      *size = __gmpfr_mulhigh_ktab_size;
+      return __gmpfr_mulhigh_ktab;
+    }
+  else if (p == MPFR_TUNE_SQRHIGH_TAB)
+    {
+      *size = __gmpfr_sqrhigh_ktab_size;
+      return __gmpfr_sqrhigh_ktab;
+    }
+  else
+    {
+      *size = __gmpfr_divhigh_ktab_size;
+      return __gmpfr_divhigh_ktab;
+    }
+}
+
+/* Return non-zero iff v is a valid value for the parameter p at index i
+   (i is ignored if p is not a table). The conditions on the tables are
+   those asserted in mulders.c. */
+static int
+tune_valid_p (mpfr_tune_t p, long i, long v)
+{
+  switch (p)
+    {
+    case MPFR_TUNE_MUL_THRESHOLD:
+    case MPFR_TUNE_SQR_THRESHOLD:
+    case MPFR_TUNE_DIV_THRESHOLD:
+      /* mul.c assumes that these thresholds (in limbs) are at least 1 */
+    case MPFR_TUNE_EXP_2_THRESHOLD:
+    case MPFR_TUNE_EXP_THRESHOLD:
+    case MPFR_TUNE_SINCOS_THRESHOLD:
+      return v >= 1 && (mpfr_uprec_t) v <= (mpfr_uprec_t) MPFR_PREC_MAX;
+    case MPFR_TUNE_AI_THRESHOLD1:
+    case MPFR_TUNE_AI_THRESHOLD2:
+    case MPFR_TUNE_AI_THRESHOLD3:
+      return 1;
+    case MPFR_TUNE_MULHIGH_TAB:
+    case MPFR_TUNE_SQRHIGH_TAB:
+      return v == -1 || v == 0 || ((i + 4) / 2 <= v && v < i);
+    case MPFR_TUNE_DIVHIGH_TAB:
+      return v == 0 || ((i + 4) / 2 <= v && v < i - 1);
+    default:
+      return 0;
+    }
+}
+
+long
+mpfr_tune_get (mpfr_tune_t p, long i)
+{
+  mp_size_t size;
+  short *tab;
+
+  switch (p)
+    {
+    case MPFR_TUNE_MUL_THRESHOLD:
+      return __gmpfr_tune.mul_threshold;
+    case MPFR_TUNE_SQR_THRESHOLD:
+      return __gmpfr_tune.sqr_threshold;
+    case MPFR_TUNE_DIV_THRESHOLD:
+      return __gmpfr_tune.div_threshold;
+    case MPFR_TUNE_EXP_2_THRESHOLD:
+      return __gmpfr_tune.exp_2_threshold;
+    case MPFR_TUNE_EXP_THRESHOLD:
+      return __gmpfr_tune.exp_threshold;
+    case MPFR_TUNE_SINCOS_THRESHOLD:
+      return __gmpfr_tune.sincos_threshold;
+    case MPFR_TUNE_AI_THRESHOLD1:
+      return __gmpfr_tune.ai_threshold1;
+    case MPFR_TUNE_AI_THRESHOLD2:
+      return __gmpfr_tune.ai_threshold2;
+    case MPFR_TUNE_AI_THRESHOLD3:
+      return __gmpfr_tune.ai_threshold3;
+    default:
+      MPFR_ASSERTN (TUNE_IS_TAB (p) && p < MPFR_TUNE_MAX);
+      tab = tune_tab (p, &size);
+      if (i == -1)
+        return size;
+      MPFR_ASSERTN (i >= 0 && i < size);
+      return tab[i];
+    }
+}
+
+int
+mpfr_tune_set (mpfr_tune_t p, long i, long v)
+{
+  mp_size_t size;
+  short *tab;
+
+  if (MPFR_UNLIKELY ((int) p < 0 || (int) p >= MPFR_TUNE_MAX ||
+                     ! tune_valid_p (p, i, v)))
+    return 1;
+
+  switch (p)
+    {
+    case MPFR_TUNE_MUL_THRESHOLD:
+      __gmpfr_tune.mul_threshold = v;
+      break;
+    case MPFR_TUNE_SQR_THRESHOLD:
+      __gmpfr_tune.sqr_threshold = v;
+      break;
+    case MPFR_TUNE_DIV_THRESHOLD:
+      __gmpfr_tune.div_threshold = v;
+      break;
+    case MPFR_TUNE_EXP_2_THRESHOLD:
+      __gmpfr_tune.exp_2_threshold = v;
+      break;
+    case MPFR_TUNE_EXP_THRESHOLD:
+      __gmpfr_tune.exp_threshold = v;
+      break;
+    case MPFR_TUNE_SINCOS_THRESHOLD:
+      __gmpfr_tune.sincos_threshold = v;
+      break;
+    case MPFR_TUNE_AI_THRESHOLD1:
+      __gmpfr_tune.ai_threshold1 = v;
+      break;
+    case MPFR_TUNE_AI_THRESHOLD2:
+      __gmpfr_tune.ai_threshold2 = v;
+      break;
+    case MPFR_TUNE_AI_THRESHOLD3:
+      __gmpfr_tune.ai_threshold3 = v;
+      break;
+    default:
+      tab = tune_tab (p, &size);
+      if (i < 0 || i >= size)
+        return 1;
+      tab[i] = (short) v;
+    }
+  return 0;
+}
+
+void
+mpfr_tune_reset (void)
+{
+  /* The fallback values for sizes beyond the tables in mulders.c are
+     only valid for large enough tables. */
+  MPFR_STAT_STATIC_ASSERT (numberof_const (mulhigh_default) >= 8);
+  MPFR_STAT_STATIC_ASSERT (numberof_const (sqrhigh_default) > 2);
+  MPFR_STAT_STATIC_ASSERT (numberof_const (divhigh_default) >= 15);
+
+  __gmpfr_tune.mul_threshold = MPFR_MUL_THRESHOLD;
+  __gmpfr_tune.sqr_threshold = MPFR_SQR_THRESHOLD;
+  __gmpfr_tune.div_threshold = MPFR_DIV_THRESHOLD;
+  __gmpfr_tune.exp_2_threshold = MPFR_EXP_2_THRESHOLD;
+  __gmpfr_tune.exp_threshold = MPFR_EXP_THRESHOLD;
+  __gmpfr_tune.sincos_threshold = MPFR_SINCOS_THRESHOLD;
+  __gmpfr_tune.ai_threshold1 = MPFR_AI_THRESHOLD1;
+  __gmpfr_tune.ai_threshold2 = MPFR_AI_THRESHOLD2;
+  __gmpfr_tune.ai_threshold3 = MPFR_AI_THRESHOLD3;
+  memcpy (__gmpfr_mulhigh_ktab, mulhigh_default, sizeof (mulhigh_default));
+  memcpy (__gmpfr_sqrhigh_ktab, sqrhigh_default, sizeof (sqrhigh_default));
+  memcpy (__gmpfr_divhigh_ktab, divhigh_default, sizeof (divhigh_default));
+}
+
+/* Read the tuning file f. The format is a sequence of entries of the form
+   "name value" for the scalar parameters and "name v0 v1 v2..." for the
+   tables (the values may span several lines, and missing values at the
+   end of a table are left unchanged), where the names are those of the
+   tune_names array. A line starting with # is a comment. This is also
+   the format written by mpfr_tune_save.
+   The new values are first stored in scal[] and tab[] (initialized with
+   the current values) and checked, so that nothing is changed in case
+   of error. Return 0 on success, non-zero on error. */
+static int
+tune_read (FILE *f, long *scal, short **tab)
+{
+  char name[32];
+  int p, c;
+  long i, v;
+
+  for (;;)
+    {
+      if (fscanf (f, "%31s", name) != 1)
+        return ferror (f) != 0;
+      if (name[0] == '#')
+        {
+          do
+            c = getc (f);
+          while (c != '\n' && c != EOF);
+          continue;
+        }
+      for (p = 0; p < MPFR_TUNE_MAX; p++)
+        if (strcmp (name, tune_names[p]) == 0)
+          break;
+      if (p == MPFR_TUNE_MAX)
+        return 1;  /* unknown parameter */
+      if (! TUNE_IS_TAB (p))
+        {
+          if (fscanf (f, "%ld", &v) != 1 ||
+              ! tune_valid_p ((mpfr_tune_t) p, 0, v))
+            return 1;
+          scal[p] = v;
+        }
+      else
+        {
+          mp_size_t size = mpfr_tune_get ((mpfr_tune_t) p, -1);
+          short *t = tab[p - MPFR_TUNE_MULHIGH_TAB];
+
+          /* Values beyond the size of the table of this build are ignored,
+             so that a file written by another build can be read. */
+          for (i = 0; fscanf (f, "%ld", &v) == 1; i++)
+            if (i < size)
+              {
+                if (! tune_valid_p ((mpfr_tune_t) p, i, v))
+                  return 1;
+                t[i] = (short) v;
+              }
+        }
+    }
+}
+
+int
+mpfr_tune_load (const char *filename)
+{
+  FILE *f;
+  long scal[MPFR_TUNE_MULHIGH_TAB];
+  short *tab[MPFR_TUNE_MAX - MPFR_TUNE_MULHIGH_TAB];
+  mp_size_t size[MPFR_TUNE_MAX - MPFR_TUNE_MULHIGH_TAB];
+  int p, k, err;
+
+  if (filename == NULL)
+    {
+      filename = getenv ("MPFR_TUNE_FILE");
+      if (filename == NULL || *filename == '\0')
+        return 0;
+    }
+
+  f = fopen (filename, "r");
+  if (f == NULL)
+    return 1;
+
+  for (p = 0; p < MPFR_TUNE_MULHIGH_TAB; p++)
+    scal[p] = mpfr_tune_get ((mpfr_tune_t) p, 0);
+  for (k = 0; k < MPFR_TUNE_MAX - MPFR_TUNE_MULHIGH_TAB; k++)
+    {
+      short *t = tune_tab ((mpfr_tune_t) (k + MPFR_TUNE_MULHIGH_TAB),
+                           &size[k]);
+      tab[k] = (short *) mpfr_allocate_func (size[k] * sizeof (short));
+      memcpy (tab[k], t, size[k] * sizeof (short));
+    }
+
+  err = tune_read (f, scal, tab);
+  if (fclose (f) != 0)
+    err = 1;
+
+  /* The values have already been checked, thus mpfr_tune_set cannot
+     fail below. */
+  if (err == 0)
+    for (p = 0; p < MPFR_TUNE_MULHIGH_TAB; p++)
+      {
+        MPFR_DBGRES (k = mpfr_tune_set ((mpfr_tune_t) p, 0, scal[p]));
+        MPFR_ASSERTD (k == 0);
+      }
+  for (k = 0; k < MPFR_TUNE_MAX - MPFR_TUNE_MULHIGH_TAB; k++)
+    {
+      if (err == 0)
+        memcpy (tune_tab ((mpfr_tune_t) (k + MPFR_TUNE_MULHIGH_TAB),
+                          &size[k]), tab[k], size[k] * sizeof (short));
+      mpfr_free_func (tab[k], size[k] * sizeof (short));
+    }
+
+  return err;
+}
+
+int
+mpfr_tune_save (const char *filename)
+{
+  FILE *f;
+  int p, err;
+  long i, size;
+
+  f = fopen (filename, "w");
+  if (f == NULL)
+    return 1;
+
+  err = fprintf (f, "# MPFR tuning parameters (default values from %s)\n",
+                 MPFR_TUNE_CASE) < 0;
+  for (p = 0; p < MPFR_TUNE_MAX && err == 0; p++)
+    if (! TUNE_IS_TAB (p))
+      err = fprintf (f, "%s %ld\n", tune_names[p],
+                     mpfr_tune_get ((mpfr_tune_t) p, 0)) < 0;
+    else
+      {
+        size = mpfr_tune_get ((mpfr_tune_t) p, -1);
+        err = fprintf (f, "%s", tune_names[p]) < 0;
+        for (i = 0; i < size && err == 0; i++)
+          err = fprintf (f, (i % 16) == 0 ? "\n %ld" : " %ld",
+                         mpfr_tune_get ((mpfr_tune_t) p, i)) < 0;
+        if (err == 0)
+          err = putc ('\n', f) == EOF;
+      }
+
+  if (fclose (f) != 0)
+    err = 1;
+  return err;
+}
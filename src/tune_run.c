@@ -0,0 +1,731 @@
+/* mpfr_tune_run -- find the best thresholds on the running processor
+
+Copyright 2005-2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include <time.h>
+#include <limits.h>
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* This is the algorithm of tune/tuneup.c, except that:
+   * the functions are not compiled again with variable thresholds, since
+     the thresholds of the library can be changed by mpfr_tune_set;
+   * the time is measured with clock() instead of GMP's speed library;
+   * each parameter is given a part of the time budget, and when this time
+     is exceeded, the search is stopped (the parameter is then unchanged,
+     except for the tables, where the entries tuned so far are kept). */
+
+/* Each measure is the minimum of TUNE_REPEAT timings of a loop taking
+   at least TUNE_MIN_CLOCKS processor time. */
+#define TUNE_REPEAT 3
+#define TUNE_MIN_CLOCKS ((clock_t) (CLOCKS_PER_SEC / 10000 + 1))
+
+/* The search for the upper bound of a threshold is stopped at this
+   precision (tuneup.c has no such bound). */
+#define TUNE_PREC_LIMIT 262144
+
+#define THRESHOLD_WINDOW 16
+#define THRESHOLD_FINAL_WINDOW 128
+#define TOLERANCE 1.00
+#define MAX_STEPS 513 /* maximum number of values of k tried for a given n */
+
+typedef struct {
+  clock_t end;      /* deadline for the current parameter (if limited) */
+  int limited;      /* non-zero if end must be taken into account */
+  int expired;      /* non-zero if the deadline has been reached */
+  mp_limb_t seed;   /* state of the pseudo-random generator */
+} tune_state;
+
+/* The operands of the measured functions. */
+typedef struct {
+  mpfr_ptr v, w, x, y;
+  mpfr_limb_ptr qp, rp, np, dp;
+  mp_size_t n;
+} tune_args;
+
+typedef void (*tune_func_t) (tune_args *);
+
+/* A simple linear congruential generator: we just need operands without
+   special patterns, and this must not depend on the caller's random state.
+   The multiplier is 1 mod 4 and the increment is odd, so that the period
+   is the maximum one for any limb size. */
+static void
+tune_random (tune_state *st, mpfr_limb_ptr p, mp_size_t n)
+{
+  while (n-- > 0)
+    {
+      st->seed = st->seed * (mp_limb_t) 1664525 + (mp_limb_t) 1013904223;
+      p[n] = st->seed;
+    }
+}
+
+/* Set x to a random number in [1/2,1). */
+static void
+tune_random_fr (tune_state *st, mpfr_ptr x)
+{
+  mp_size_t n = MPFR_LIMB_SIZE (x);
+  int sh;
+
+  tune_random (st, MPFR_MANT (x), n);
+  MPFR_MANT (x)[n - 1] |= MPFR_LIMB_HIGHBIT;
+  MPFR_UNSIGNED_MINUS_MODULO (sh, MPFR_PREC (x));
+  MPFR_MANT (x)[0] &= ~MPFR_LIMB_MASK (sh);
+  MPFR_SET_EXP (x, 0);
+  MPFR_SET_POS (x);
+}
+
+/* Return the time taken by f (a) in clock ticks (as a double). */
+static double
+tune_time (tune_state *st, tune_func_t f, tune_args *a)
+{
+  unsigned long i, reps = 1;
+  clock_t c0, c1;
+  double t, tmin = 0.0;
+  int j;
+
+  for (j = 0; j < TUNE_REPEAT; j++)
+    {
+      for (;;)
+        {
+          c0 = clock ();
+          for (i = 0; i < reps; i++)
+            f (a);
+          c1 = clock ();
+          if (c1 - c0 >= TUNE_MIN_CLOCKS)
+            break;
+          reps *= 2;
+        }
+      t = (double) (c1 - c0) / (double) reps;
+      if (j == 0 || t < tmin)
+        tmin = t;
+    }
+  if (st->limited && c1 > st->end)
+    st->expired = 1;
+  return tmin;
+}
+
+static void
+tune_mul (tune_args *a)
+{
+  mpfr_mul (a->w, a->x, a->y, MPFR_RNDN);
+}
+
+/* Like tuneup.c, use mpfr_mul (w, x, x) for the squaring. */
+static void
+tune_sqr (tune_args *a)
+{
+  mpfr_mul (a->w, a->x, a->x, MPFR_RNDN);
+}
+
+static void
+tune_div (tune_args *a)
+{
+  mpfr_div (a->w, a->x, a->y, MPFR_RNDN);
+}
+
+static void
+tune_exp_2 (tune_args *a)
+{
+  mpfr_exp_2 (a->w, a->x, MPFR_RNDN);
+}
+
+static void
+tune_exp (tune_args *a)
+{
+  mpfr_exp (a->w, a->x, MPFR_RNDN);
+}
+
+static void
+tune_sincos (tune_args *a)
+{
+  mpfr_sin_cos (a->v, a->w, a->x, MPFR_RNDN);
+}
+
+static void
+tune_ai (tune_args *a)
+{
+  mpfr_ai (a->w, a->x, MPFR_RNDN);
+}
+
+static void
+tune_mulhigh (tune_args *a)
+{
+  mpfr_mulhigh_n (a->rp, a->np, a->dp, a->n);
+}
+
+static void
+tune_sqrhigh (tune_args *a)
+{
+  mpfr_sqrhigh_n (a->rp, a->np, a->n);
+}
+
+/* mpfr_divhigh_n clobbers its dividend, thus work on a copy */
+static void
+tune_divhigh (tune_args *a)
+{
+  MPN_COPY (a->rp, a->np, 2 * a->n);
+  mpfr_divhigh_n (a->qp, a->rp, a->dp, a->n);
+}
+
+/* Return the relative difference d between the time of the first
+   algorithm (used for low precision, obtained with the largest value of the
+   threshold p) and the time of the second one (obtained with 1).
+   d > 0 if we have to use algo 1, d < 0 if we have to use algo 2. */
+static double
+domeasure (tune_state *st, mpfr_tune_t param, tune_func_t f,
+           mpfr_prec_t p)
+{
+  mpfr_t v, w, x, y;
+  tune_args a;
+  double t1, t2, d;
+
+  mpfr_inits2 (p, v, w, x, y, (mpfr_ptr) 0);
+  tune_random_fr (st, x);
+  tune_random_fr (st, y);
+  a.v = v;
+  a.w = w;
+  a.x = x;
+  a.y = y;
+
+  MPFR_DBGRES (mpfr_tune_set (param, 0, MPFR_PREC_MAX));
+  t1 = tune_time (st, f, &a);
+  MPFR_DBGRES (mpfr_tune_set (param, 0, 1));
+  t2 = tune_time (st, f, &a);
+  mpfr_clears (v, w, x, y, (mpfr_ptr) 0);
+
+  if (t2 >= t1)
+    d = (t2 - t1) / t2;
+  else
+    d = (t2 - t1) / t1;
+  return d;
+}
+
+/* Same as domeasure for mpfr_ai, when both the precision p and the point
+   of evaluation x vary. It assumes that mpfr_ai depends on three thresholds
+   with a boundary of the form threshold1*x + threshold2*p = some scaling
+   factor, if x<0, and threshold3*x + threshold2*p = some scaling factor,
+   if x>=0. */
+static double
+domeasure2 (tune_state *st, mpfr_prec_t p, mpfr_srcptr x)
+{
+  mpfr_t w, xtmp;
+  tune_args a;
+  double t1, t2, d;
+
+  MPFR_ASSERTD (MPFR_IS_PURE_FP (x));
+
+  mpfr_init2 (w, p);
+  mpfr_init2 (xtmp, p);
+  tune_random_fr (st, xtmp);
+  MPFR_SET_EXP (xtmp, -53);
+  mpfr_add_ui (xtmp, xtmp, 1, MPFR_RNDN);
+  mpfr_mul (xtmp, xtmp, x, MPFR_RNDN); /* xtmp = x*(1+perturb)       */
+                                       /* where perturb ~ 2^(-53) is */
+                                       /* randomly chosen.           */
+  a.w = w;
+  a.x = xtmp;
+
+  __gmpfr_tune.ai_threshold1 = 0;
+  __gmpfr_tune.ai_threshold2 = 0;
+  __gmpfr_tune.ai_threshold3 = 0;
+  t1 = tune_time (st, tune_ai, &a);
+
+  if (MPFR_IS_NEG (x))
+    __gmpfr_tune.ai_threshold1 = INT_MIN;
+  else
+    __gmpfr_tune.ai_threshold3 = INT_MAX;
+  __gmpfr_tune.ai_threshold2 = INT_MAX;
+  t2 = tune_time (st, tune_ai, &a);
+
+  mpfr_clear (w);
+  mpfr_clear (xtmp);
+
+  if (t2 >= t1)
+    d = (t2 - t1) / t2;
+  else
+    d = (t2 - t1) / t1;
+  return d;
+}
+
+static int
+analyze_data (double *dat, int ndat)
+{
+  double  x, min_x;
+  int     j, min_j;
+
+  x = 0.0;
+  for (j = 0; j < ndat; j++)
+    if (dat[j] > 0.0)
+      x += dat[j];
+
+  min_x = x;
+  min_j = 0;
+
+  for (j = 0; j < ndat; x -= dat[j], j++)
+    {
+      if (x < min_x)
+        {
+          min_x = x;
+          min_j = j;
+        }
+    }
+  return min_j;
+}
+
+/* Tune a function with a simple threshold, and return it (in bits) in
+   *threshold, unless the time is exceeded (st->expired is then set).
+   It assumes that the function uses algo1 if p < threshold and algo2
+   otherwise. If algo2 is better for low prec, and algo1 better for high
+   prec, the result is unspecified. */
+static void
+tune_simple_func (tune_state *st, mpfr_prec_t *threshold,
+                  mpfr_tune_t param, tune_func_t f, mpfr_prec_t pstart)
+{
+  double measure[THRESHOLD_FINAL_WINDOW+1];
+  double d = -1.0;
+  mpfr_prec_t pstep;
+  int i, numpos, numneg, tries;
+  mpfr_prec_t pmin, pmax, p;
+
+  /* first look for a lower bound within 10% */
+  pmin = p = pstart;
+  for (i = 0; i < 10 && d < 0.0 && !st->expired; i++)
+    d = domeasure (st, param, f, pmin);
+  if (d < 0.0)
+    {
+      /* even for precision pmin, algo 2 seems to be faster */
+      *threshold = pmin;
+      return;
+    }
+  if (d >= 1.00)
+    while (!st->expired)
+      {
+        d = domeasure (st, param, f, pmin);
+        if (d < 1.00)
+          break;
+        p = pmin;
+        pmin += pmin/2;
+      }
+  pmin = p;
+  while (!st->expired)
+    {
+      d = domeasure (st, param, f, pmin);
+      if (d < 0.10 || pmin >= TUNE_PREC_LIMIT)
+        break;
+      pmin += GMP_NUMB_BITS;
+    }
+
+  /* then look for an upper bound within 20% */
+  pmax = pmin * 2;
+  while (!st->expired)
+    {
+      d = domeasure (st, param, f, pmax);
+      if (d < -0.20 || pmax >= TUNE_PREC_LIMIT)
+        break;
+      pmax += pmin / 2; /* don't increase too rapidly */
+    }
+
+  /* The threshold is between pmin and pmax. Affine them */
+  tries = 0;
+  while ((pmax-pmin) >= THRESHOLD_FINAL_WINDOW && !st->expired)
+    {
+      pstep = MAX(MIN(GMP_NUMB_BITS/2,(pmax-pmin)/(2*THRESHOLD_WINDOW)),1);
+      p = (pmin + pmax) / 2;
+      for (i = numpos = numneg = 0 ; i < THRESHOLD_WINDOW + 1 ; i++)
+        {
+          measure[i] = domeasure (st, param, f,
+                                  p+(i-THRESHOLD_WINDOW/2)*pstep);
+          if (measure[i] > 0)
+            numpos ++;
+          else if (measure[i] < 0)
+            numneg ++;
+        }
+      if (numpos > numneg)
+        /* We use more often algo 1 than algo 2 */
+        pmin = p - THRESHOLD_WINDOW/2*pstep;
+      else if (numpos < numneg)
+        pmax = p + THRESHOLD_WINDOW/2*pstep;
+      else
+        /* numpos == numneg ... */
+        if (++ tries > 2)
+          {
+            *threshold = p;
+            return;
+          }
+    }
+
+  /* Final tune... */
+  for (i = 0 ; i < THRESHOLD_FINAL_WINDOW+1 && !st->expired ; i++)
+    measure[i] = domeasure (st, param, f, pmin+i);
+  i = analyze_data (measure, THRESHOLD_FINAL_WINDOW+1);
+  *threshold = pmin + i;
+}
+
+/* Tune mpfr_ai in a given direction.
+   It assumes that for (x,p) close to zero, algo1 is used
+   and algo2 is used when (x,p) is far from zero.
+   This tuning function tries couples (x,p) of the form (ell*dirx, ell*dirp)
+   until it finds a point on the boundary, which is returned in (xres,pres),
+   unless the time is exceeded (st->expired is then set). */
+static void
+tune_ai_in_some_direction (tune_state *st, mpfr_prec_t pstart,
+                           int dirx, int dirp,
+                           mpfr_ptr xres, mpfr_prec_t *pres)
+{
+  double measure[THRESHOLD_FINAL_WINDOW+1];
+  double d;
+  mpfr_prec_t pstep;
+  int i, numpos, numneg, tries;
+  mpfr_prec_t pmin, pmax, p;
+  mpfr_t xmin, xmax, x;
+  mpfr_t ratio;
+
+  mpfr_init2 (ratio, MPFR_SMALL_PRECISION);
+  mpfr_set_si (ratio, dirx, MPFR_RNDN);
+  mpfr_div_si (ratio, ratio, dirp, MPFR_RNDN);
+
+  mpfr_init2 (xmin, MPFR_SMALL_PRECISION);
+  mpfr_init2 (xmax, MPFR_SMALL_PRECISION);
+  mpfr_init2 (x, MPFR_SMALL_PRECISION);
+
+  /* first look for a lower bound within 10% */
+  pmin = p = pstart;
+  mpfr_mul_ui (xmin, ratio, (unsigned int)pmin, MPFR_RNDN);
+  mpfr_set (x, xmin, MPFR_RNDN);
+
+  d = domeasure2 (st, pmin, xmin);
+  if (d < 0.0)
+    {
+      /* even for pmin, algo 2 seems to be faster */
+      *pres = MPFR_PREC_MIN;
+      mpfr_mul_ui (xres, ratio, (unsigned int)*pres, MPFR_RNDN);
+      goto end;
+    }
+  if (d >= 1.00)
+    while (!st->expired)
+      {
+        d = domeasure2 (st, pmin, xmin);
+        if (d < 1.00)
+          break;
+        p = pmin;
+        mpfr_set (x, xmin, MPFR_RNDN);
+        pmin += pmin/2;
+        mpfr_mul_ui (xmin, ratio, (unsigned int)pmin, MPFR_RNDN);
+      }
+  pmin = p;
+  mpfr_set (xmin, x, MPFR_RNDN);
+  while (!st->expired)
+    {
+      d = domeasure2 (st, pmin, xmin);
+      if (d < 0.10 || pmin >= TUNE_PREC_LIMIT)
+        break;
+      pmin += GMP_NUMB_BITS;
+      mpfr_mul_ui (xmin, ratio, (unsigned int)pmin, MPFR_RNDN);
+    }
+
+  /* then look for an upper bound within 20% */
+  pmax = pmin * 2;
+  mpfr_mul_ui (xmax, ratio, (unsigned int)pmax, MPFR_RNDN);
+  while (!st->expired)
+    {
+      d = domeasure2 (st, pmax, xmax);
+      if (d < -0.20 || pmax >= TUNE_PREC_LIMIT)
+        break;
+      pmax += pmin / 2; /* don't increase too rapidly */
+      mpfr_mul_ui (xmax, ratio, (unsigned int)pmax, MPFR_RNDN);
+    }
+
+  /* The threshold is between pmin and pmax. Affine them */
+  tries = 0;
+  while ((pmax-pmin) >= THRESHOLD_FINAL_WINDOW && !st->expired)
+    {
+      pstep = MAX(MIN(GMP_NUMB_BITS/2,(pmax-pmin)/(2*THRESHOLD_WINDOW)),1);
+      p = (pmin + pmax) / 2;
+      mpfr_mul_ui (x, ratio, (unsigned int)p, MPFR_RNDN);
+      for (i = numpos = numneg = 0 ; i < THRESHOLD_WINDOW + 1 ; i++)
+        {
+          *pres = p+(i-THRESHOLD_WINDOW/2)*pstep;
+          mpfr_mul_ui (xres, ratio, (unsigned int)*pres, MPFR_RNDN);
+          measure[i] = domeasure2 (st, *pres, xres);
+          if (measure[i] > 0)
+            numpos ++;
+          else if (measure[i] < 0)
+            numneg ++;
+        }
+      if (numpos > numneg)
+        {
+          /* We use more often algo 1 than algo 2 */
+          pmin = p - THRESHOLD_WINDOW/2*pstep;
+          mpfr_mul_ui (xmin, ratio, (unsigned int)pmin, MPFR_RNDN);
+        }
+      else if (numpos < numneg)
+        {
+          pmax = p + THRESHOLD_WINDOW/2*pstep;
+          mpfr_mul_ui (xmax, ratio, (unsigned int)pmax, MPFR_RNDN);
+        }
+      else
+        /* numpos == numneg ... */
+        if (++ tries > 2)
+          {
+            *pres = p;
+            mpfr_mul_ui (xres, ratio, (unsigned int)*pres, MPFR_RNDN);
+            goto end;
+          }
+    }
+
+  /* Final tune... */
+  for (i = 0 ; i < THRESHOLD_FINAL_WINDOW+1 && !st->expired ; i++)
+    {
+      *pres = pmin+i;
+      mpfr_mul_ui (xres, ratio, (unsigned int)*pres, MPFR_RNDN);
+      measure[i] = domeasure2 (st, *pres, xres);
+    }
+  i = analyze_data (measure, THRESHOLD_FINAL_WINDOW+1);
+  *pres = pmin + i;
+  mpfr_mul_ui (xres, ratio, (unsigned int)*pres, MPFR_RNDN);
+
+ end:
+  mpfr_clear (ratio); mpfr_clear (x); mpfr_clear (xmin); mpfr_clear (xmax);
+}
+
+/* Tune the entry n of the table param (MPFR_TUNE_MULHIGH_TAB,
+   MPFR_TUNE_SQRHIGH_TAB or MPFR_TUNE_DIVHIGH_TAB), i.e., the cutoff point k
+   of Mulders' algorithm for size n. */
+static void
+tune_mulders (tune_state *st, mpfr_tune_t param, mp_size_t n)
+{
+  tune_func_t f;
+  tune_args a;
+  mp_size_t k, kbest, step;
+  double t, tbest;
+  MPFR_TMP_DECL (marker);
+
+  if (param == MPFR_TUNE_DIVHIGH_TAB ? n <= 2 : n == 0)
+    {
+      /* we require n > 2 in mpfr_divhigh */
+      MPFR_DBGRES (mpfr_tune_set (param, n,
+                                  param == MPFR_TUNE_DIVHIGH_TAB ? 0 : -1));
+      return;
+    }
+
+  MPFR_TMP_MARK (marker);
+  a.n = n;
+  a.np = MPFR_TMP_LIMBS_ALLOC (2 * n);
+  a.dp = MPFR_TMP_LIMBS_ALLOC (n);
+  a.rp = MPFR_TMP_LIMBS_ALLOC (2 * n);
+  a.qp = MPFR_TMP_LIMBS_ALLOC (n);
+  tune_random (st, a.np, 2 * n);
+  tune_random (st, a.dp, n);
+  a.dp[n - 1] |= MPFR_LIMB_HIGHBIT;
+
+  if (param == MPFR_TUNE_DIVHIGH_TAB)
+    {
+      /* Check k == 0, i.e., mpfr_divhigh_n_basecase */
+      f = tune_divhigh;
+      kbest = 0;
+    }
+  else
+    {
+      /* Check k == -1, mpn_mul_basecase or mpn_sqr_basecase */
+      f = param == MPFR_TUNE_MULHIGH_TAB ? tune_mulhigh : tune_sqrhigh;
+      kbest = -1;
+    }
+  MPFR_DBGRES (mpfr_tune_set (param, n, kbest));
+  tbest = tune_time (st, f, &a);
+
+  if (param != MPFR_TUNE_DIVHIGH_TAB)
+    {
+      /* Check k == 0, mpfr_mulhigh_n_basecase */
+      MPFR_DBGRES (mpfr_tune_set (param, n, 0));
+      t = tune_time (st, f, &a);
+      if (t * TOLERANCE < tbest)
+        kbest = 0, tbest = t;
+    }
+
+  /* Check Mulders with cutoff point k: we need k >= (n+3)/2, which
+     translates into k >= (n+4)/2 in C, and k < n, and even k < n-1
+     for the division */
+  step = 1 + n / (2 * MAX_STEPS);
+  for (k = (n + 4) / 2;
+       k < (param == MPFR_TUNE_DIVHIGH_TAB ? n - 1 : n) && !st->expired;
+       k += step)
+    {
+      MPFR_DBGRES (mpfr_tune_set (param, n, k));
+      t = tune_time (st, f, &a);
+      if (t * TOLERANCE < tbest)
+        kbest = k, tbest = t;
+    }
+
+  MPFR_DBGRES (mpfr_tune_set (param, n, kbest));
+  MPFR_TMP_FREE (marker);
+}
+
+/* Find the best values of the thresholds, trying to spend at most about
+   msec milliseconds of processor time if msec > 0 (the time actually spent
+   can be a bit larger). The parameters are tuned in their dependency order,
+   the remaining time being shared equally among the remaining parameters.
+   Return 0 if all the parameters could be tuned, non-zero otherwise. */
+#define TUNE_NPARAMS 10
+
+int
+mpfr_tune_run (long msec)
+{
+  tune_state st;
+  clock_t end = 0, now;
+  mpfr_prec_t threshold;
+  mpfr_t x1, x2, x3, tmp1, tmp2;
+  mpfr_prec_t p1, p2, p3;
+  long old1, old2, old3;
+  mp_size_t n, size;
+  int i, ret = 0;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  now = clock ();
+  if (now == (clock_t) -1)
+    return 1;  /* no processor time available */
+
+  MPFR_SAVE_EXPO_MARK (expo);
+
+  st.limited = msec > 0;
+  if (st.limited)
+    end = now + (clock_t) ((double) msec * (CLOCKS_PER_SEC / 1000.0));
+  st.seed = 0;
+
+  for (i = 0; i < TUNE_NPARAMS; i++)
+    {
+      mpfr_tune_t param = (mpfr_tune_t) (i < 3 ? MPFR_TUNE_MULHIGH_TAB + i
+                                         : i - 3);
+
+      if (st.limited)
+        {
+          now = clock ();
+          if (now >= end)
+            {
+              ret = 1;
+              break;
+            }
+          st.end = now + (end - now) / (TUNE_NPARAMS - i);
+        }
+      st.expired = 0;
+
+      switch (i)
+        {
+        case 0: /* mulhigh */
+        case 1: /* sqrhigh */
+        case 2: /* divhigh */
+          size = mpfr_tune_get (param, -1);
+          for (n = 0; n < size && !st.expired; n++)
+            tune_mulders (&st, param, n);
+          break;
+        case 3: /* mul: the threshold is in limbs, but it doesn't matter */
+        case 4: /* sqr: too much, as in tuneup.c */
+        case 5: /* div */
+        case 6: /* exp_2 */
+        case 7: /* exp */
+        case 8: /* sin_cos */
+          {
+            static const tune_func_t func[] =
+              { tune_mul, tune_sqr, tune_div, tune_exp_2, tune_exp,
+                tune_sincos };
+            static const mpfr_prec_t pstart[] =
+              { 2*GMP_NUMB_BITS+1, 2*GMP_NUMB_BITS+1, 2*GMP_NUMB_BITS+1,
+                GMP_NUMB_BITS, MPFR_PREC_MIN+3*GMP_NUMB_BITS,
+                MPFR_PREC_MIN+3*GMP_NUMB_BITS };
+            long old = mpfr_tune_get (param, 0);
+            mpfr_prec_t p0 = pstart[i - 3], hint;
+
+            /* Unlike tuneup.c, start from half the current value if the
+               first algorithm is still the fastest there, which saves
+               much time when the current value is not too far. */
+            hint = (i <= 5 ? old * GMP_NUMB_BITS : old) / 2;
+            if (hint > p0 && hint <= TUNE_PREC_LIMIT &&
+                domeasure (&st, param, func[i - 3], hint) > 0.0)
+              p0 = hint;
+            tune_simple_func (&st, &threshold, param, func[i - 3], p0);
+            if (st.expired)
+              MPFR_DBGRES (mpfr_tune_set (param, 0, old));
+            else if (i <= 5)
+              MPFR_DBGRES (mpfr_tune_set (param, 0, (threshold - 1)
+                                          / GMP_NUMB_BITS + 1));
+            else
+              MPFR_DBGRES (mpfr_tune_set (param, 0, threshold));
+          }
+          break;
+        default: /* ai */
+          old1 = __gmpfr_tune.ai_threshold1;
+          old2 = __gmpfr_tune.ai_threshold2;
+          old3 = __gmpfr_tune.ai_threshold3;
+          mpfr_init2 (x1, MPFR_SMALL_PRECISION);
+          mpfr_init2 (x2, MPFR_SMALL_PRECISION);
+          mpfr_init2 (x3, MPFR_SMALL_PRECISION);
+          mpfr_init2 (tmp1, MPFR_SMALL_PRECISION);
+          mpfr_init2 (tmp2, MPFR_SMALL_PRECISION);
+
+          tune_ai_in_some_direction (&st, MPFR_PREC_MIN+GMP_NUMB_BITS,
+                                     -60, 200, x1, &p1);
+          if (!st.expired)
+            tune_ai_in_some_direction (&st, MPFR_PREC_MIN+GMP_NUMB_BITS,
+                                       -20, 500, x2, &p2);
+          if (!st.expired)
+            tune_ai_in_some_direction (&st, MPFR_PREC_MIN+GMP_NUMB_BITS,
+                                       40, 200, x3, &p3);
+
+          if (st.expired)
+            {
+              __gmpfr_tune.ai_threshold1 = old1;
+              __gmpfr_tune.ai_threshold2 = old2;
+              __gmpfr_tune.ai_threshold3 = old3;
+            }
+          else
+            {
+              mpfr_mul_ui (tmp1, x2, (unsigned long)p1, MPFR_RNDN);
+              mpfr_mul_ui (tmp2, x1, (unsigned long)p2, MPFR_RNDN);
+              mpfr_sub (tmp1, tmp1, tmp2, MPFR_RNDN);
+              mpfr_div_ui (tmp1, tmp1, MPFR_AI_SCALE, MPFR_RNDN);
+
+              mpfr_set_ui (tmp2, (unsigned long)p1, MPFR_RNDN);
+              mpfr_sub_ui (tmp2, tmp2, (unsigned long)p2, MPFR_RNDN);
+              mpfr_div (tmp2, tmp2, tmp1, MPFR_RNDN);
+              __gmpfr_tune.ai_threshold1 = mpfr_get_si (tmp2, MPFR_RNDN);
+
+              mpfr_sub (tmp2, x2, x1, MPFR_RNDN);
+              mpfr_div (tmp2, tmp2, tmp1, MPFR_RNDN);
+              __gmpfr_tune.ai_threshold2 = mpfr_get_si (tmp2, MPFR_RNDN);
+
+              mpfr_set_ui (tmp1, (unsigned long)p3, MPFR_RNDN);
+              mpfr_mul_si (tmp1, tmp1, __gmpfr_tune.ai_threshold2,
+                           MPFR_RNDN);
+              mpfr_ui_sub (tmp1, MPFR_AI_SCALE, tmp1, MPFR_RNDN);
+              mpfr_div (tmp1, tmp1, x3, MPFR_RNDN);
+              __gmpfr_tune.ai_threshold3 = mpfr_get_si (tmp1, MPFR_RNDN);
+            }
+
+          mpfr_clear (x1); mpfr_clear (x2); mpfr_clear (x3);
+          mpfr_clear (tmp1); mpfr_clear (tmp2);
+        }
+
+      if (st.expired)
+        ret = 1;
+    }
+
+  MPFR_SAVE_EXPO_FREE (expo);
+  return ret;
+}
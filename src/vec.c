@@ -0,0 +1,449 @@
+/* mpfr_vec_init2, mpfr_vec_clear, mpfr_vec_view, mpfr_vec_update ...
+   -- vectors of numbers of the same precision (structure of arrays)
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* The signs, the exponents and the significands are stored in 3 separate
+   blocks (this avoids alignment issues between mpfr_exp_t and mp_limb_t).
+   The significands are stored one after the other, with the stride
+   MPFR_PREC2LIMBS (prec), so that the elements can be processed in
+   increasing order with a sequential memory access. A view of element i
+   is a mpfr_t as created by mpfr_custom_init_set, whose significand is
+   the one in the vector, and whose sign and exponent are copies (they
+   must be written back with mpfr_vec_update after a modification). */
+
+#define VEC_LIMBS(v) MPFR_PREC2LIMBS ((v)->_mpfr_vec_prec)
+
+/* number of views built on the stack at a time by the operations below */
+#define VEC_CHUNK 32
+
+void
+mpfr_vec_init2 (mpfr_vec_ptr v, unsigned long n, mpfr_prec_t p)
+{
+  mp_size_t k;
+  unsigned long i;
+
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+  k = MPFR_PREC2LIMBS (p);
+  /* check that the sizes in bytes below do not overflow */
+  MPFR_ASSERTN (n <= (size_t) -1 / ((size_t) k * MPFR_BYTES_PER_MP_LIMB));
+
+  v->_mpfr_vec_prec = p;
+  v->_mpfr_vec_size = n;
+  if (n == 0)
+    {
+      v->_mpfr_vec_sign = NULL;
+      v->_mpfr_vec_exp = NULL;
+      v->_mpfr_vec_d = NULL;
+      return;
+    }
+  v->_mpfr_vec_sign = (mpfr_sign_t *)
+    mpfr_allocate_func (n * sizeof (mpfr_sign_t));
+  v->_mpfr_vec_exp = (mpfr_exp_t *)
+    mpfr_allocate_func (n * sizeof (mpfr_exp_t));
+  v->_mpfr_vec_d = (mp_limb_t *)
+    mpfr_allocate_func (n * k * MPFR_BYTES_PER_MP_LIMB);
+  /* initialize all the elements to NaN, as done by mpfr_init2 */
+  for (i = 0; i < n; i++)
+    {
+      v->_mpfr_vec_sign[i] = MPFR_SIGN_POS;
+      v->_mpfr_vec_exp[i] = MPFR_EXP_NAN;
+    }
+}
+
+void
+mpfr_vec_clear (mpfr_vec_ptr v)
+{
+  unsigned long n = v->_mpfr_vec_size;
+
+  if (n != 0)
+    {
+      mpfr_free_func (v->_mpfr_vec_sign, n * sizeof (mpfr_sign_t));
+      mpfr_free_func (v->_mpfr_vec_exp, n * sizeof (mpfr_exp_t));
+      mpfr_free_func (v->_mpfr_vec_d,
+                      n * VEC_LIMBS (v) * MPFR_BYTES_PER_MP_LIMB);
+    }
+  v->_mpfr_vec_size = 0;
+  v->_mpfr_vec_sign = NULL;
+  v->_mpfr_vec_exp = NULL;
+  v->_mpfr_vec_d = NULL;
+}
+
+mpfr_prec_t
+mpfr_vec_get_prec (mpfr_vec_srcptr v)
+{
+  return v->_mpfr_vec_prec;
+}
+
+unsigned long
+mpfr_vec_size (mpfr_vec_srcptr v)
+{
+  return v->_mpfr_vec_size;
+}
+
+/* Same as mpfr_custom_init_set (x, kind, exp, prec, significand) with the
+   data of element i of v, but without the conversion from/to the kind. */
+#define VEC_VIEW(x,v,i)                                                 \
+  do {                                                                  \
+    MPFR_PREC (x) = (v)->_mpfr_vec_prec;                                \
+    MPFR_SIGN (x) = (v)->_mpfr_vec_sign[i];                             \
+    MPFR_EXP (x) = (v)->_mpfr_vec_exp[i];                               \
+    MPFR_MANT (x) = (v)->_mpfr_vec_d + (i) * VEC_LIMBS (v);             \
+  } while (0)
+
+void
+mpfr_vec_view (mpfr_ptr x, mpfr_vec_srcptr v, unsigned long i)
+{
+  MPFR_ASSERTN (i < v->_mpfr_vec_size);
+  VEC_VIEW (x, v, i);
+}
+
+void
+mpfr_vec_update (mpfr_vec_ptr v, unsigned long i, mpfr_srcptr x)
+{
+  MPFR_ASSERTN (i < v->_mpfr_vec_size);
+  MPFR_ASSERTN (MPFR_PREC (x) == v->_mpfr_vec_prec &&
+                MPFR_MANT (x) == v->_mpfr_vec_d + i * VEC_LIMBS (v));
+  v->_mpfr_vec_sign[i] = MPFR_SIGN (x);
+  v->_mpfr_vec_exp[i] = MPFR_EXP (x);
+}
+
+int
+mpfr_vec_set (mpfr_vec_ptr v, unsigned long i, mpfr_srcptr x,
+              mpfr_rnd_t rnd_mode)
+{
+  mpfr_t y;
+  int inex;
+
+  MPFR_ASSERTN (i < v->_mpfr_vec_size);
+  VEC_VIEW (y, v, i);
+  inex = mpfr_set (y, x, rnd_mode);
+  v->_mpfr_vec_sign[i] = MPFR_SIGN (y);
+  v->_mpfr_vec_exp[i] = MPFR_EXP (y);
+  return inex;
+}
+
+int
+mpfr_vec_get (mpfr_ptr x, mpfr_vec_srcptr v, unsigned long i,
+              mpfr_rnd_t rnd_mode)
+{
+  mpfr_t y;
+
+  MPFR_ASSERTN (i < v->_mpfr_vec_size);
+  VEC_VIEW (y, v, i);
+  return mpfr_set (x, y, rnd_mode);
+}
+
+/* Compute r[i] = x[i] + y[i] (op = 0), x[i] * y[i] (op = 1) or
+   x[i] * y[i] + z[i] (op = 2) for i0 <= i < i1, and t[i-i0] to the
+   ternary value if t is not a null pointer, with mpfr_add_vec,
+   mpfr_mul_vec and mpfr_fma_vec on chunks of views. An input vector may
+   be the same as r: in this case, the same view is used for the input
+   and the output, since the MPFR functions do not support different
+   mpfr_t sharing their significand. */
+static int
+vec_op (int op, mpfr_vec_ptr r, mpfr_vec_srcptr x, mpfr_vec_srcptr y,
+        mpfr_vec_srcptr z, unsigned long i0, unsigned long i1,
+        mpfr_rnd_t rnd_mode, int *t)
+{
+  __mpfr_struct rv[VEC_CHUNK], xv[VEC_CHUNK], yv[VEC_CHUNK], zv[VEC_CHUNK];
+  mpfr_ptr rp[VEC_CHUNK], xp[VEC_CHUNK], yp[VEC_CHUNK], zp[VEC_CHUNK];
+  unsigned long i, j, k;
+  int res = 0;
+
+  for (i = i0; i < i1; i += k)
+    {
+      k = MIN (i1 - i, VEC_CHUNK);
+      for (j = 0; j < k; j++)
+        {
+          VEC_VIEW (rv + j, r, i + j);
+          rp[j] = rv + j;
+          if (x == r)
+            xp[j] = rp[j];
+          else
+            {
+              VEC_VIEW (xv + j, x, i + j);
+              xp[j] = xv + j;
+            }
+          if (y == r)
+            yp[j] = rp[j];
+          else
+            {
+              VEC_VIEW (yv + j, y, i + j);
+              yp[j] = yv + j;
+            }
+          if (op == 2)
+            {
+              if (z == r)
+                zp[j] = rp[j];
+              else
+                {
+                  VEC_VIEW (zv + j, z, i + j);
+                  zp[j] = zv + j;
+                }
+            }
+        }
+      res |= op == 0 ?
+        mpfr_add_vec (rp, xp, yp, k, rnd_mode, t == NULL ? NULL : t + i - i0)
+        : op == 1 ?
+        mpfr_mul_vec (rp, xp, yp, k, rnd_mode, t == NULL ? NULL : t + i - i0)
+        : mpfr_fma_vec (rp, xp, yp, zp, k, rnd_mode,
+                        t == NULL ? NULL : t + i - i0);
+      for (j = 0; j < k; j++)
+        {
+          r->_mpfr_vec_sign[i + j] = MPFR_SIGN (rv + j);
+          r->_mpfr_vec_exp[i + j] = MPFR_EXP (rv + j);
+        }
+    }
+  return res;
+}
+
+#if !defined(MPFR_GENERIC_ABI)
+
+/* Branch-free kernels for vectors of the same precision p < GMP_NUMB_BITS
+   (one limb per element), working directly on the arrays of the vectors.
+   They follow mpfr_mul_1 and mpfr_add1sp1, but the tests are replaced by
+   selections, so that the compiler can vectorize the loops (e.g. with the
+   AVX2 or AVX-512 clones when configured with --enable-fmv). The elements
+   these kernels cannot handle (singular inputs, possible overflow or
+   underflow, and for the addition, inputs with different signs) are left
+   unchanged and computed by vec_op afterwards.
+   The rounding mode is given by rndn (MPFR_RNDN), apos (round away from
+   zero for a positive result) and aneg (the same for a negative result);
+   rndf (MPFR_RNDF) just gives a zero ternary value. */
+
+/* Round the lane (a0, ex, rb, sb) of sign sgn, and set tern to the ternary
+   value. */
+#define VEC_ROUND_1(a0,ex,rb,sb,sgn,tern)                               \
+  do {                                                                  \
+    mp_limb_t inex_ = (rb) | (sb);                                      \
+    int away_ = inex_ != 0 &&                                           \
+      (rndn ? (rb) != 0 && ((sb) != 0 || ((a0) & ulp) != 0)             \
+       : (sgn) > 0 ? apos : aneg);                                      \
+    (a0) += away_ ? ulp : 0;                                            \
+    (ex) += (a0) == 0;                                                  \
+    (a0) = (a0) == 0 ? MPFR_LIMB_HIGHBIT : (a0);                        \
+    (tern) = inex_ == 0 || rndf ? 0 : away_ ? (sgn) : - (sgn);          \
+  } while (0)
+
+/* Store the lane, unless it is marked as slow. */
+#define VEC_STORE_1(r,i,a0,ex,sgn,slow)                                 \
+  do {                                                                  \
+    (r)->_mpfr_vec_d[i] = (slow) ? (r)->_mpfr_vec_d[i] : (a0);          \
+    (r)->_mpfr_vec_exp[i] = (slow) ? (r)->_mpfr_vec_exp[i] : (ex);      \
+    (r)->_mpfr_vec_sign[i] = (slow) ? (r)->_mpfr_vec_sign[i] : (sgn);   \
+  } while (0)
+
+#define VEC_KERNEL_PARAMS                                               \
+  mpfr_vec_ptr r, mpfr_vec_srcptr x, mpfr_vec_srcptr y,                 \
+  unsigned long i0, unsigned long i1, int rndn, int apos, int aneg,     \
+  int rndf, int *t, unsigned char *slow
+
+/* r[i] = x[i] * y[i]; if half is non-zero, p <= GMP_NUMB_BITS / 2, so that
+   the product is exact on one limb (and can be vectorized). */
+static MPFR_TARGET_CLONES_ATTR int
+vec_mul_1 (VEC_KERNEL_PARAMS, int half)
+{
+  mpfr_prec_t sh = GMP_NUMB_BITS - r->_mpfr_vec_prec;
+  mp_limb_t mask = MPFR_LIMB_MASK (sh), rbit = MPFR_LIMB_ONE << (sh - 1);
+  mp_limb_t ulp = MPFR_LIMB_ONE << sh;
+  mpfr_exp_t emin = __gmpfr_emin, emax = __gmpfr_emax;
+  unsigned long i;
+  int any = 0;
+
+  for (i = i0; i < i1; i++)
+    {
+      mp_limb_t b0 = x->_mpfr_vec_d[i], c0 = y->_mpfr_vec_d[i];
+      mpfr_exp_t bx = x->_mpfr_vec_exp[i], cx = y->_mpfr_vec_exp[i];
+      int sing = (bx <= MPFR_EXP_INF) | (cx <= MPFR_EXP_INF);
+      int sgn = MPFR_MULT_SIGN (x->_mpfr_vec_sign[i], y->_mpfr_vec_sign[i]);
+      mp_limb_t a0, rb, sb, norm;
+      mpfr_exp_t ex, ex0;
+      int tern, sl;
+
+      /* the exponents of singular values must not be added (overflow) */
+      ex = (sing ? 0 : bx) + (sing ? 0 : cx);
+      if (half)
+        {
+          a0 = (b0 >> (GMP_NUMB_BITS / 2)) * (c0 >> (GMP_NUMB_BITS / 2));
+          sb = 0;
+        }
+      else
+        umul_ppmm (a0, sb, b0, c0);
+      norm = a0 >> (GMP_NUMB_BITS - 1);
+      a0 = norm ? a0 : (a0 << 1) | (sb >> (GMP_NUMB_BITS - 1));
+      sb = norm ? sb : sb << 1;
+      ex -= 1 - (mpfr_exp_t) norm;
+      ex0 = ex;
+      rb = a0 & rbit;
+      sb |= (a0 & mask) ^ rb;
+      a0 &= ~mask;
+      VEC_ROUND_1 (a0, ex, rb, sb, sgn, tern);
+      sl = sing | (ex0 < emin) | (ex > emax);
+      VEC_STORE_1 (r, i, a0, ex, sgn, sl);
+      t[i - i0] = tern;
+      slow[i - i0] = sl;
+      any |= sl ? 0 : tern;
+    }
+  return any;
+}
+
+/* r[i] = x[i] + y[i] */
+static MPFR_TARGET_CLONES_ATTR int
+vec_add_1 (VEC_KERNEL_PARAMS)
+{
+  mpfr_prec_t sh = GMP_NUMB_BITS - r->_mpfr_vec_prec;
+  mp_limb_t mask = MPFR_LIMB_MASK (sh), rbit = MPFR_LIMB_ONE << (sh - 1);
+  mp_limb_t ulp = MPFR_LIMB_ONE << sh;
+  mpfr_exp_t emax = __gmpfr_emax;
+  unsigned long i;
+  int any = 0;
+
+  for (i = i0; i < i1; i++)
+    {
+      mp_limb_t b0 = x->_mpfr_vec_d[i], c0 = y->_mpfr_vec_d[i];
+      mpfr_exp_t bx = x->_mpfr_vec_exp[i], cx = y->_mpfr_vec_exp[i];
+      int sgn = x->_mpfr_vec_sign[i];
+      int sing = (bx <= MPFR_EXP_INF) | (cx <= MPFR_EXP_INF)
+        | (sgn != y->_mpfr_vec_sign[i]);
+      int swap = bx < cx;
+      mp_limb_t hb = swap ? c0 : b0, lb = swap ? b0 : c0;
+      mpfr_exp_t ex = swap ? cx : bx;
+      mpfr_uexp_t d = swap ? (mpfr_uexp_t) cx - (mpfr_uexp_t) bx
+        : (mpfr_uexp_t) bx - (mpfr_uexp_t) cx;
+      int big = d >= GMP_NUMB_BITS;
+      /* the shift counts below are always in [0, GMP_NUMB_BITS - 1] */
+      unsigned int ds = big ? 0 : (unsigned int) d;
+      mp_limb_t a0, rb, sb, carry;
+      int tern, sl;
+
+      /* bits of lb shifted out (lb is non-zero) */
+      sb = big ? 1 : ds == 0 ? 0 : lb << ((GMP_NUMB_BITS - ds)
+                                         % GMP_NUMB_BITS);
+      a0 = hb + (big ? 0 : lb >> ds);
+      carry = a0 < hb;
+      sb |= carry & a0;
+      a0 = carry ? MPFR_LIMB_HIGHBIT | (a0 >> 1) : a0;
+      ex += (mpfr_exp_t) carry;
+      rb = a0 & rbit;
+      sb |= (a0 & mask) ^ rb;
+      a0 &= ~mask;
+      VEC_ROUND_1 (a0, ex, rb, sb, sgn, tern);
+      sl = sing | (ex > emax);
+      VEC_STORE_1 (r, i, a0, ex, sgn, sl);
+      t[i - i0] = tern;
+      slow[i - i0] = sl;
+      any |= sl ? 0 : tern;
+    }
+  return any;
+}
+
+/* Run the kernel on chunks of elements, then vec_op on the slow ones,
+   and set *res to the value to be returned by mpfr_vec_add/mpfr_vec_mul.
+   Return 0 if the kernels cannot be used, a non-zero value otherwise. */
+static int
+vec_kernel_1 (int op, mpfr_vec_ptr r, mpfr_vec_srcptr x, mpfr_vec_srcptr y,
+              mpfr_rnd_t rnd_mode, int *t, int *res)
+{
+  mpfr_prec_t p = r->_mpfr_vec_prec;
+  unsigned long n = r->_mpfr_vec_size, i, j, k;
+  int tt[VEC_CHUNK], rndn, apos, aneg, rndf, any = 0;
+  unsigned char slow[VEC_CHUNK];
+
+  if (p >= GMP_NUMB_BITS || x->_mpfr_vec_prec != p ||
+      y->_mpfr_vec_prec != p)
+    return 0;
+
+  *res = 0;
+  rndn = rnd_mode == MPFR_RNDN;
+  rndf = rnd_mode == MPFR_RNDF;
+  apos = rnd_mode == MPFR_RNDU || rnd_mode == MPFR_RNDA;
+  aneg = rnd_mode == MPFR_RNDD || rnd_mode == MPFR_RNDA;
+
+  for (i = 0; i < n; i += k)
+    {
+      k = MIN (n - i, VEC_CHUNK);
+      any |= op == 0 ?
+        vec_add_1 (r, x, y, i, i + k, rndn, apos, aneg, rndf, tt, slow)
+        : vec_mul_1 (r, x, y, i, i + k, rndn, apos, aneg, rndf, tt, slow,
+                     p <= GMP_NUMB_BITS / 2);
+      for (j = 0; j < k; j++)
+        {
+          if (MPFR_UNLIKELY (slow[j]))
+            vec_op (op, r, x, y, NULL, i + j, i + j + 1, rnd_mode, tt + j);
+          *res |= tt[j];
+          if (t != NULL)
+            t[i + j] = tt[j];
+        }
+    }
+  /* the inexact flag for the slow elements has been set by vec_op */
+  if (any != 0)
+    __gmpfr_flags |= MPFR_FLAGS_INEXACT;
+  return 1;
+}
+
+#endif
+
+int
+mpfr_vec_add (mpfr_vec_ptr r, mpfr_vec_srcptr x, mpfr_vec_srcptr y,
+              mpfr_rnd_t rnd_mode, int *t)
+{
+  MPFR_ASSERTN (x->_mpfr_vec_size == r->_mpfr_vec_size &&
+                y->_mpfr_vec_size == r->_mpfr_vec_size);
+#if !defined(MPFR_GENERIC_ABI)
+  {
+    int res;
+
+    if (vec_kernel_1 (0, r, x, y, rnd_mode, t, &res))
+      return res;
+  }
+#endif
+  return vec_op (0, r, x, y, NULL, 0, r->_mpfr_vec_size, rnd_mode, t);
+}
+
+int
+mpfr_vec_mul (mpfr_vec_ptr r, mpfr_vec_srcptr x, mpfr_vec_srcptr y,
+              mpfr_rnd_t rnd_mode, int *t)
+{
+  MPFR_ASSERTN (x->_mpfr_vec_size == r->_mpfr_vec_size &&
+                y->_mpfr_vec_size == r->_mpfr_vec_size);
+#if !defined(MPFR_GENERIC_ABI)
+  {
+    int res;
+
+    if (vec_kernel_1 (1, r, x, y, rnd_mode, t, &res))
+      return res;
+  }
+#endif
+  return vec_op (1, r, x, y, NULL, 0, r->_mpfr_vec_size, rnd_mode, t);
+}
+
+int
+mpfr_vec_fma (mpfr_vec_ptr r, mpfr_vec_srcptr x, mpfr_vec_srcptr y,
+              mpfr_vec_srcptr z, mpfr_rnd_t rnd_mode, int *t)
+{
+  MPFR_ASSERTN (x->_mpfr_vec_size == r->_mpfr_vec_size &&
+                y->_mpfr_vec_size == r->_mpfr_vec_size &&
+                z->_mpfr_vec_size == r->_mpfr_vec_size);
+  return vec_op (2, r, x, y, z, 0, r->_mpfr_vec_size, rnd_mode, t);
+}
@@ -531,6 +531,9 @@ mpfr_zeta (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
       MPFR_RET (0);
     }
 
+  if (MPFR_SPECULATE_P (MPFR_PREC (z)))
+    return mpfr_speculate (z, s, rnd_mode, mpfr_zeta);
+
   MPFR_SAVE_EXPO_MARK (expo);
 
   /* Compute Zeta */
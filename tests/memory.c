@@ -70,7 +70,9 @@ size_t tests_memory_limit = DEFAULT_MEMORY_LIMIT;
    with several threads are added and executed whether the shared cache
    is enabled or not, thread locking should be enabled together with TLS
    whenever possible, and when it is unavailable, these multithread tests
-   must not be run. */
+   must not be run.
+   The worker threads of the parallel mode (--enable-parallel) also use
+   these functions; thread locking is thus enabled in this mode too. */
 static struct header  *tests_memory_list;
 static size_t tests_total_size = 0;
 static size_t tests_max_size = 0;
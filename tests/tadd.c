@@ -1329,6 +1329,71 @@ test_rndf_exact (mp_size_t pmax)
 #define RAND_FUNCTION(x) mpfr_random2(x, MPFR_LIMB_SIZE (x), randlimb () % 100, RANDS)
 #include "tgeneric.c"
 
+/* Check the additions and subtractions with operands having trailing
+   zero limbs, which are ignored by mpfr_add1 and mpfr_sub1: the results
+   must be the same as with the same values in a small precision. */
+static void
+check_sparse (void)
+{
+  mpfr_t x, y, x1, y1, a1, a2;
+  mpfr_prec_t q, p;
+  int i, r, inex1, inex2;
+
+  mpfr_inits2 (1000, x1, y1, a1, a2, (mpfr_ptr) 0);
+  for (i = 0; i < 200; i++)
+    {
+      q = 1 + randlimb () % 200;
+      p = 4 * q + randlimb () % 1000;
+      mpfr_init2 (x, q);
+      mpfr_init2 (y, 1 + randlimb () % 1000);
+      mpfr_set_prec (x1, p);
+      mpfr_set_prec (y1, mpfr_get_prec (y));
+      mpfr_set_prec (a1, 1 + randlimb () % 1000);
+      mpfr_set_prec (a2, mpfr_get_prec (a1));
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, (int) (randlimb () % 200) - 100, MPFR_RNDN);
+      if (randlimb () & 1)
+        mpfr_neg (x, x, MPFR_RNDN);
+      mpfr_urandomb (y, RANDS);
+      mpfr_set (x1, x, MPFR_RNDN);  /* exact */
+      mpfr_set (y1, y, MPFR_RNDN);
+      RND_LOOP (r)
+        {
+          inex1 = mpfr_add (a1, x1, y1, (mpfr_rnd_t) r);
+          inex2 = mpfr_add (a2, x, y, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse (add) for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              exit (1);
+            }
+          inex1 = mpfr_sub (a1, y1, x1, (mpfr_rnd_t) r);
+          inex2 = mpfr_sub (a2, y, x, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse (sub) for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              exit (1);
+            }
+          /* a1 reused, its trailing zero limbs must not be skipped */
+          mpfr_set_prec (a1, p);
+          mpfr_set (a1, x1, MPFR_RNDN);
+          inex1 = mpfr_sub (a1, a1, y, (mpfr_rnd_t) r);
+          mpfr_set_prec (a2, p);
+          inex2 = mpfr_sub (a2, x, y, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse (reuse) for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              exit (1);
+            }
+        }
+      mpfr_clear (x);
+      mpfr_clear (y);
+    }
+  mpfr_clears (x1, y1, a1, a2, (mpfr_ptr) 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1345,6 +1410,7 @@ main (int argc, char *argv[])
   test_rndf_exact (200);
   testall_rndf (7);
   check_extreme ();
+  check_sparse ();
 
   test_generic (MPFR_PREC_MIN, 1000, 100);
 
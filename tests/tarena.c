@@ -0,0 +1,159 @@
+/* Test file for mpfr_set_arena_size and mpfr_get_arena_size.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static int (*const func[]) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t) = {
+  mpfr_exp, mpfr_log, mpfr_atan, mpfr_gamma, mpfr_sin, mpfr_erf };
+
+#define NFUNC (sizeof (func) / sizeof (func[0]))
+
+/* Count the calls to the GMP allocation functions. */
+static void *(*old_allocate) (size_t);
+static void *(*old_reallocate) (void *, size_t, size_t);
+static void (*old_free) (void *, size_t);
+static unsigned long nalloc;
+
+static void *
+count_allocate (size_t n)
+{
+  nalloc++;
+  return old_allocate (n);
+}
+
+static void *
+count_reallocate (void *p, size_t old_size, size_t new_size)
+{
+  nalloc++;
+  return old_reallocate (p, old_size, new_size);
+}
+
+static void
+count_free (void *p, size_t n)
+{
+  old_free (p, n);
+}
+
+static void
+check_size (void)
+{
+  void *p;
+
+  MPFR_ASSERTN (mpfr_get_arena_size () == 0);
+  MPFR_ASSERTN (mpfr_set_arena_size (1000) == 0);
+  MPFR_ASSERTN (mpfr_get_arena_size () >= 1000);
+
+  /* the size cannot be changed while a block is used */
+  p = mpfr_arena_allocate (100);
+  MPFR_ASSERTN (mpfr_set_arena_size (0) != 0);
+  MPFR_ASSERTN (mpfr_get_arena_size () >= 1000);
+  mpfr_free_pool ();
+  mpfr_arena_free (p, 100);
+
+  MPFR_ASSERTN (mpfr_set_arena_size (0) == 0);
+  MPFR_ASSERTN (mpfr_get_arena_size () == 0);
+}
+
+/* Check that the results do not depend on the arena, with an arena too
+   small for all the temporary variables (size0) and a large one. */
+static void
+check_results (size_t size0)
+{
+  mpfr_t x, y, z;
+  mpfr_prec_t p;
+  int i, inex1, inex2;
+
+  mpfr_inits2 (1000, x, y, z, (mpfr_ptr) 0);
+  for (p = 1000; p <= 10000; p += 3000)
+    {
+      mpfr_set_prec (x, p);
+      mpfr_set_prec (y, p);
+      mpfr_set_prec (z, p);
+      mpfr_urandomb (x, RANDS);
+      mpfr_add_ui (x, x, 1, MPFR_RNDN);
+      for (i = 0; i < (int) NFUNC; i++)
+        {
+          MPFR_ASSERTN (mpfr_set_arena_size (0) == 0);
+          inex1 = func[i] (y, x, MPFR_RNDN);
+          MPFR_ASSERTN (mpfr_set_arena_size (size0) == 0);
+          inex2 = func[i] (z, x, MPFR_RNDN);
+          if (! mpfr_equal_p (y, z) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error for function %d in precision %ld with an arena"
+                      " of %lu bytes\n", i, (long) p, (unsigned long) size0);
+              exit (1);
+            }
+        }
+    }
+  mpfr_clears (x, y, z, (mpfr_ptr) 0);
+  MPFR_ASSERTN (mpfr_set_arena_size (0) == 0);
+}
+
+/* Check that the arena avoids calls to the allocation functions. */
+static void
+check_allocations (void)
+{
+  mpfr_t x, y;
+  unsigned long n0, n1;
+
+  mpfr_init2 (x, 5000);
+  mpfr_init2 (y, 5000);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  mpfr_sqrt (x, x, MPFR_RNDN);
+  /* fill the caches and the pool */
+  mpfr_log (y, x, MPFR_RNDN);
+
+  mp_get_memory_functions (&old_allocate, &old_reallocate, &old_free);
+  mp_set_memory_functions (count_allocate, count_reallocate, count_free);
+  nalloc = 0;
+  mpfr_log (y, x, MPFR_RNDN);
+  n0 = nalloc;
+  MPFR_ASSERTN (mpfr_set_arena_size (1 << 18) == 0);
+  mpfr_log (y, x, MPFR_RNDN);  /* allocates the arena */
+  nalloc = 0;
+  mpfr_log (y, x, MPFR_RNDN);
+  n1 = nalloc;
+  MPFR_ASSERTN (mpfr_set_arena_size (0) == 0);
+  mp_set_memory_functions (old_allocate, old_reallocate, old_free);
+
+  if (n1 >= n0)
+    {
+      printf ("Error, %lu allocations with the arena, %lu without it\n",
+              n1, n0);
+      exit (1);
+    }
+  mpfr_clear (x);
+  mpfr_clear (y);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_size ();
+  check_results (256);
+  check_results (1 << 18);
+  check_allocations ();
+
+  tests_end_mpfr ();
+  return 0;
+}
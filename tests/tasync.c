@@ -0,0 +1,178 @@
+/* Test file for mpfr_async_const, mpfr_async_unary, mpfr_async_binary,
+   mpfr_async_poll and mpfr_async_wait.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static void
+check_result (const char *s, mpfr_srcptr y1, mpfr_srcptr y2,
+              int inex1, int inex2, mpfr_flags_t flags1,
+              mpfr_flags_t flags2)
+{
+  if (! mpfr_equal_p (y1, y2) || MPFR_SIGN (y1) != MPFR_SIGN (y2) ||
+      ! SAME_SIGN (inex1, inex2) || flags1 != flags2)
+    {
+      printf ("Error in %s with %u threads\n", s, mpfr_get_num_threads ());
+      printf ("expected ");
+      mpfr_dump (y1);
+      printf ("got      ");
+      mpfr_dump (y2);
+      printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+      flags_out (flags1);
+      flags_out (flags2);
+      exit (1);
+    }
+}
+
+/* Check that several asynchronous computations give the same results,
+   ternary values and flags as the synchronous calls. */
+static void
+check_basic (void)
+{
+  mpfr_t x, y, z[3], t[3];
+  mpfr_async_t a[3];
+  int inex[3], i;
+  mpfr_flags_t flags1, flags2;
+
+  mpfr_init2 (x, 100);
+  mpfr_init2 (y, 100);
+  for (i = 0; i < 3; i++)
+    mpfr_inits2 (2000, z[i], t[i], (mpfr_ptr) 0);
+  mpfr_set_ui (x, 17, MPFR_RNDN);
+  mpfr_set_si (y, -3, MPFR_RNDN);
+
+  mpfr_clear_flags ();
+  inex[0] = mpfr_const_pi (t[0], MPFR_RNDU);
+  inex[1] = mpfr_sqrt (t[1], x, MPFR_RNDD);
+  inex[2] = mpfr_div (t[2], x, y, MPFR_RNDZ);
+  flags1 = __gmpfr_flags;
+
+  mpfr_clear_flags ();
+  mpfr_async_const (a[0], mpfr_const_pi, z[0], MPFR_RNDU);
+  mpfr_async_unary (a[1], mpfr_sqrt, z[1], x, MPFR_RNDD);
+  mpfr_async_binary (a[2], mpfr_div, z[2], x, y, MPFR_RNDZ);
+  /* the computations are done independently of the current flags */
+  mpfr_set_erangeflag ();
+  while (! mpfr_async_poll (a[2]))
+    ;
+  MPFR_ASSERTN (mpfr_async_poll (a[2]));
+  for (i = 0; i < 3; i++)
+    {
+      int inex2 = mpfr_async_wait (a[i]);
+      MPFR_ASSERTN (SAME_SIGN (inex2, inex[i]));
+      if (! mpfr_equal_p (z[i], t[i]))
+        {
+          printf ("Error in check_basic for i = %d with %u threads\n", i,
+                  mpfr_get_num_threads ());
+          exit (1);
+        }
+    }
+  flags2 = __gmpfr_flags;
+  if (flags2 != (flags1 | MPFR_FLAGS_ERANGE))
+    {
+      printf ("Error in check_basic: wrong flags with %u threads\n",
+              mpfr_get_num_threads ());
+      flags_out (flags1 | MPFR_FLAGS_ERANGE);
+      flags_out (flags2);
+      exit (1);
+    }
+
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+  for (i = 0; i < 3; i++)
+    mpfr_clears (z[i], t[i], (mpfr_ptr) 0);
+}
+
+/* Check that the exponent range of the submitting thread is used, and
+   that an overflow or an underflow is signaled by mpfr_async_wait. */
+static void
+check_range (void)
+{
+  mpfr_exp_t emin, emax;
+  mpfr_t x, y1, y2;
+  int inex1, inex2;
+  mpfr_flags_t flags1, flags2;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+
+  mpfr_init2 (x, 53);
+  mpfr_inits2 (53, y1, y2, (mpfr_ptr) 0);
+
+  set_emax (10);
+  mpfr_set_ui (x, 1000, MPFR_RNDN);
+  mpfr_clear_flags ();
+  inex1 = mpfr_exp (y1, x, MPFR_RNDN);
+  flags1 = __gmpfr_flags;
+  mpfr_clear_flags ();
+  {
+    mpfr_async_t a;
+
+    mpfr_async_unary (a, mpfr_exp, y2, x, MPFR_RNDN);
+    /* the exponent range of the submitting thread at the time of the
+       submission is used */
+    set_emax (emax);
+    inex2 = mpfr_async_wait (a);
+  }
+  flags2 = __gmpfr_flags;
+  check_result ("check_range (overflow)", y1, y2, inex1, inex2,
+                flags1, flags2);
+  MPFR_ASSERTN (mpfr_inf_p (y2) && flags2 & MPFR_FLAGS_OVERFLOW);
+
+  set_emin (-10);
+  mpfr_set_si (x, -1000, MPFR_RNDN);
+  mpfr_clear_flags ();
+  inex1 = mpfr_exp (y1, x, MPFR_RNDU);
+  flags1 = __gmpfr_flags;
+  mpfr_clear_flags ();
+  {
+    mpfr_async_t a;
+
+    mpfr_async_unary (a, mpfr_exp, y2, x, MPFR_RNDU);
+    set_emin (emin);
+    inex2 = mpfr_async_wait (a);
+  }
+  flags2 = __gmpfr_flags;
+  check_result ("check_range (underflow)", y1, y2, inex1, inex2,
+                flags1, flags2);
+  MPFR_ASSERTN (flags2 & MPFR_FLAGS_UNDERFLOW);
+
+  mpfr_clears (x, y1, y2, (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  unsigned int n;
+
+  tests_start_mpfr ();
+
+  for (n = 1; n <= 3; n++)
+    {
+      if (mpfr_set_num_threads (n) != 0 && n > 1)
+        break;
+      check_basic ();
+      check_range ();
+    }
+  mpfr_set_num_threads (1);
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,159 @@
+/* Test file for the cache of the Bernoulli numbers (mpfr_bernoulli_cache).
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+/* mpfr_bernoulli_cache(n) returns T[n] = B[2n]*(2n+1)!. Since
+   sum(binomial(2n+1,2j)*B[2j], j=0..n) = (2n+1)/2 for n >= 1, we have
+   sum(binomial(2n+1,2j)*(2n+1)!/(2j+1)!*T[j], j=0..n) = (2n+1)*(2n+1)!/2,
+   which determines T[n] from T[0], ..., T[n-1]. Check this identity for
+   0 < n <= nmax, the T[j] being requested in increasing order, or after
+   the table has been filled up to nmax at once. */
+static void
+check_identity (unsigned long nmax, int increasing)
+{
+  mpz_t lhs, rhs, c, f;
+  unsigned long n, j, k;
+
+  mpfr_free_cache ();
+  if (! increasing)
+    mpfr_bernoulli_cache (nmax);
+
+  mpz_init (lhs);
+  mpz_init (rhs);
+  mpz_init (c);
+  mpz_init (f);
+  MPFR_ASSERTN (mpz_cmp_ui (mpfr_bernoulli_cache (0), 1) == 0);
+  for (n = 1; n <= nmax; n++)
+    {
+      mpz_set_ui (lhs, 0);
+      for (j = 0; j <= n; j++)
+        {
+          /* c = binomial(2n+1,2j) * (2n+1)!/(2j+1)! */
+          mpz_bin_uiui (c, 2 * n + 1, 2 * j);
+          for (k = 2 * j + 2; k <= 2 * n + 1; k++)
+            mpz_mul_ui (c, c, k);
+          mpz_addmul (lhs, c, mpfr_bernoulli_cache (j));
+        }
+      mpz_fac_ui (f, 2 * n + 1);
+      mpz_mul_ui (rhs, f, 2 * n + 1);
+      mpz_mul_2exp (lhs, lhs, 1);
+      if (mpz_cmp (lhs, rhs) != 0)
+        {
+          printf ("Error in mpfr_bernoulli_cache for n = %lu (%s)\n", n,
+                  increasing ? "increasing order" : "computed at once");
+          exit (1);
+        }
+    }
+  mpz_clear (lhs);
+  mpz_clear (rhs);
+  mpz_clear (c);
+  mpz_clear (f);
+}
+
+/* The pointers returned by mpfr_bernoulli_cache must remain valid when
+   the table grows. */
+static void
+check_stable (void)
+{
+  mpz_srcptr b1, b2;
+  mpz_t x;
+
+  mpfr_free_cache ();
+  b1 = mpfr_bernoulli_cache (3);
+  mpz_init_set (x, b1);
+  b2 = mpfr_bernoulli_cache (500);
+  MPFR_ASSERTN (mpz_cmp (b1, x) == 0);
+  MPFR_ASSERTN (mpfr_bernoulli_cache (3) == b1);
+  MPFR_ASSERTN (mpfr_bernoulli_cache (500) == b2);
+  mpz_clear (x);
+}
+
+#if defined(MPFR_WANT_SHARED_CACHE) && defined(HAVE_PTHREAD)
+
+# include <pthread.h>
+
+#define NTHREADS 8
+#define NMAX 300
+
+static mpz_srcptr result[NTHREADS][NMAX + 1];
+
+static void *
+start_routine (void *arg)
+{
+  int i = *(int *) arg;
+  unsigned long n;
+
+  /* the threads request the numbers in different orders */
+  for (n = 0; n <= NMAX; n++)
+    result[i][i % 2 ? NMAX - n : n] =
+      mpfr_bernoulli_cache (i % 2 ? NMAX - n : n);
+  /* the mpz_t pool is local to the thread */
+  mpfr_free_cache2 (MPFR_FREE_LOCAL_CACHE);
+  return NULL;
+}
+
+/* With the shared cache, all the threads get the same numbers. */
+static void
+check_threads (void)
+{
+  pthread_t thread_id[NTHREADS];
+  int table[NTHREADS];
+  int i, err;
+  unsigned long n;
+
+  mpfr_free_cache ();
+  for (i = 0; i < NTHREADS; i++)
+    {
+      table[i] = i;
+      err = pthread_create (&thread_id[i], NULL, start_routine, &table[i]);
+      MPFR_ASSERTN (err == 0);
+    }
+  for (i = 0; i < NTHREADS; i++)
+    {
+      err = pthread_join (thread_id[i], NULL);
+      MPFR_ASSERTN (err == 0);
+    }
+  for (i = 1; i < NTHREADS; i++)
+    for (n = 0; n <= NMAX; n++)
+      MPFR_ASSERTN (result[i][n] == result[0][n]);
+  check_identity (NMAX, 1);
+}
+
+#else
+
+# define check_threads() ((void) 0)
+
+#endif
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_identity (150, 1);
+  check_identity (150, 0);
+  check_stable ();
+  check_threads ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,168 @@
+/* Test file for mpfr_set_cache_budget and mpfr_get_cache_budget.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define BOTH ((mpfr_free_cache_t) (MPFR_FREE_LOCAL_CACHE | \
+                                   MPFR_FREE_GLOBAL_CACHE))
+
+static size_t
+cache_bytes (void)
+{
+  mpfr_memory_stats_t s;
+
+  mpfr_get_memory_stats (&s);
+  return s.cache_bytes;
+}
+
+/* Check that pi in precision p, in all the rounding modes, has the same
+   value and ternary value as without the budget. */
+static void
+check_pi (mpfr_prec_t p, size_t budget)
+{
+  mpfr_t x, y;
+  int r, inex1, inex2;
+
+  mpfr_inits2 (p, x, y, (mpfr_ptr) 0);
+  RND_LOOP_NO_RNDF (r)
+    {
+      mpfr_set_cache_budget (BOTH, (size_t) -1);
+      inex1 = mpfr_const_pi (x, (mpfr_rnd_t) r);
+      mpfr_set_cache_budget (BOTH, budget);
+      MPFR_ASSERTN (cache_bytes () <= budget);
+      inex2 = mpfr_const_pi (y, (mpfr_rnd_t) r);
+      MPFR_ASSERTN (cache_bytes () <= budget);
+      if (! mpfr_equal_p (x, y) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in check_pi for p = %lu, budget = %lu, %s\n",
+                  (unsigned long) p, (unsigned long) budget,
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+          printf ("expected "); mpfr_dump (x);
+          printf ("got      "); mpfr_dump (y);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          exit (1);
+        }
+    }
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+static void
+check_default (void)
+{
+  MPFR_ASSERTN (mpfr_get_cache_budget (MPFR_FREE_LOCAL_CACHE)
+                == (size_t) -1);
+  MPFR_ASSERTN (mpfr_get_cache_budget (MPFR_FREE_GLOBAL_CACHE)
+                == (size_t) -1);
+  mpfr_set_cache_budget (MPFR_FREE_LOCAL_CACHE, 12345);
+  MPFR_ASSERTN (mpfr_get_cache_budget (MPFR_FREE_LOCAL_CACHE) == 12345);
+  mpfr_set_cache_budget (MPFR_FREE_LOCAL_CACHE, (size_t) -1);
+}
+
+/* A large constant is rounded to a lower precision when the budget is
+   set, and a constant which does not fit is not cached. */
+static void
+check_shrink (void)
+{
+  mpfr_t x;
+
+  mpfr_free_cache ();
+  mpfr_init2 (x, 20000);
+  mpfr_const_pi (x, MPFR_RNDN);
+  mpfr_const_log2 (x, MPFR_RNDN);
+  MPFR_ASSERTN (cache_bytes () >= 40000 / CHAR_BIT);
+
+  mpfr_set_cache_budget (BOTH, 3000);
+  MPFR_ASSERTN (cache_bytes () <= 3000);
+  /* the constants are still cached, but in a smaller precision */
+  MPFR_ASSERTN (cache_bytes () > 0);
+  mpfr_clear (x);
+
+  check_pi (100, 3000);
+  check_pi (1000, 3000);
+  check_pi (20000, 3000);
+  check_pi (20000, 0);
+
+  mpfr_set_cache_budget (BOTH, (size_t) -1);
+  mpfr_free_cache ();
+}
+
+/* The table of the Bernoulli numbers is freed if it exceeds the budget. */
+static void
+check_bernoulli (void)
+{
+  mpfr_t x, y;
+
+  mpfr_free_cache ();
+  mpfr_inits2 (100, x, y, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 1000, MPFR_RNDN);
+  mpfr_gamma (y, x, MPFR_RNDN);  /* uses the Bernoulli numbers */
+  MPFR_ASSERTN (mpfr_bernoulli_cache_bytes () > 0);
+
+  mpfr_set_cache_budget (BOTH, 0);
+  MPFR_ASSERTN (cache_bytes () == 0);
+  mpfr_gamma (x, x, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_equal_p (x, y));
+
+  mpfr_set_cache_budget (BOTH, (size_t) -1);
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+  mpfr_free_cache ();
+}
+
+/* The mpz_t pool keeps at most the local budget. */
+static void
+check_pool (void)
+{
+  mpfr_memory_stats_t s;
+  mpfr_t x, y;
+
+  mpfr_inits2 (10000, x, y, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  mpfr_set_cache_budget (MPFR_FREE_LOCAL_CACHE, 1000);
+  mpfr_sqrt (x, x, MPFR_RNDN);
+  mpfr_exp (y, x, MPFR_RNDN);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.pool_bytes <= 1000);
+
+  mpfr_set_cache_budget (MPFR_FREE_LOCAL_CACHE, 0);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.pool_bytes == 0);
+  mpfr_exp (y, x, MPFR_RNDN);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.pool_bytes == 0);
+
+  mpfr_set_cache_budget (MPFR_FREE_LOCAL_CACHE, (size_t) -1);
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+  mpfr_free_cache ();
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_default ();
+  check_shrink ();
+  check_bernoulli ();
+  check_pool ();
+
+  tests_end_mpfr ();
+  return 0;
+}
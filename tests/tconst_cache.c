@@ -0,0 +1,150 @@
+/* Test file for mpfr_const_cache_load and mpfr_const_cache_save.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define FILE_NAME   "tconst_cache.dat"  /* temporary name */
+#define FILE_NAME_2 "tconst_cache2.dat" /* temporary name (invalid files) */
+
+#define PREC 2000
+
+/* Check that x = c(rnd) with the right ternary value inex, where c is
+   computed without the cache. */
+static void
+check_value (mpfr_ptr x, int inex, int (*c) (mpfr_ptr, mpfr_rnd_t),
+             mpfr_rnd_t rnd, const char *s)
+{
+  mpfr_t y;
+  int inex_ref;
+
+  mpfr_init2 (y, MPFR_PREC (x));
+  inex_ref = c (y, rnd);
+  if (! SAME_VAL (x, y) || VSIGN (inex) != VSIGN (inex_ref))
+    {
+      printf ("Error for %s, prec = %lu, %s\n", s,
+              (unsigned long) MPFR_PREC (x), mpfr_print_rnd_mode (rnd));
+      printf ("expected "), mpfr_dump (y);
+      printf ("got      "), mpfr_dump (x);
+      printf ("expected inex = %d, got %d\n", inex_ref, inex);
+      exit (1);
+    }
+  mpfr_clear (y);
+}
+
+/* Check that pi and log(2) are taken from the loaded file, in precision
+   PREC, and that Euler's constant is computed. */
+static void
+check_loaded (void)
+{
+  mpfr_t x;
+  int inex, r;
+
+  mpfr_free_cache ();
+  mpfr_init2 (x, 100);
+  RND_LOOP_NO_RNDF (r)
+    {
+      inex = mpfr_const_pi (x, (mpfr_rnd_t) r);
+      check_value (x, inex, mpfr_const_pi_internal, (mpfr_rnd_t) r, "pi");
+      inex = mpfr_const_log2 (x, (mpfr_rnd_t) r);
+      check_value (x, inex, mpfr_const_log2_internal, (mpfr_rnd_t) r,
+                   "log2");
+    }
+  MPFR_ASSERTN (MPFR_PREC (__gmpfr_cache_const_pi->snap->x) == PREC);
+  MPFR_ASSERTN (MPFR_PREC (__gmpfr_cache_const_log2->snap->x) == PREC);
+
+  inex = mpfr_const_euler (x, MPFR_RNDN);
+  check_value (x, inex, mpfr_const_euler_internal, MPFR_RNDN, "euler");
+  MPFR_ASSERTN (MPFR_PREC (__gmpfr_cache_const_euler->snap->x) == 100);
+
+  /* a higher precision than the one in the file */
+  mpfr_set_prec (x, PREC + 1);
+  inex = mpfr_const_pi (x, MPFR_RNDZ);
+  check_value (x, inex, mpfr_const_pi_internal, MPFR_RNDZ, "pi");
+  MPFR_ASSERTN (MPFR_PREC (__gmpfr_cache_const_pi->snap->x) > PREC);
+
+  mpfr_clear (x);
+}
+
+/* Write the first n bytes of FILE_NAME to FILE_NAME_2, with the byte
+   at position i (if i < n) replaced by c. */
+static void
+write_bad_file (long n, long i, int c)
+{
+  FILE *f, *g;
+  long k;
+  int b;
+
+  f = fopen (FILE_NAME, "rb");
+  g = fopen (FILE_NAME_2, "wb");
+  MPFR_ASSERTN (f != NULL && g != NULL);
+  for (k = 0; k < n && (b = getc (f)) != EOF; k++)
+    putc (k == i ? c : b, g);
+  fclose (f);
+  MPFR_ASSERTN (fclose (g) == 0);
+}
+
+static void
+check_save_load (void)
+{
+  mpfr_t x;
+
+  mpfr_free_cache ();
+  mpfr_init2 (x, PREC);
+  mpfr_const_pi (x, MPFR_RNDN);
+  mpfr_const_log2 (x, MPFR_RNDN);
+  mpfr_clear (x);
+  MPFR_ASSERTN (mpfr_const_cache_save (FILE_NAME) == 0);
+
+  MPFR_ASSERTN (mpfr_const_cache_load (FILE_NAME) == 0);
+  check_loaded ();
+
+  /* invalid files, which must not replace the loaded one */
+  MPFR_ASSERTN (mpfr_const_cache_load ("nonexistent.dat") != 0);
+  write_bad_file (5, -1, 0);  /* truncated header */
+  MPFR_ASSERTN (mpfr_const_cache_load (FILE_NAME_2) != 0);
+  write_bad_file (100, -1, 0);  /* truncated entry */
+  MPFR_ASSERTN (mpfr_const_cache_load (FILE_NAME_2) != 0);
+  write_bad_file (LONG_MAX, 0, 'X');  /* bad magic */
+  MPFR_ASSERTN (mpfr_const_cache_load (FILE_NAME_2) != 0);
+  write_bad_file (LONG_MAX, 8, 99);  /* bad version */
+  MPFR_ASSERTN (mpfr_const_cache_load (FILE_NAME_2) != 0);
+  write_bad_file (LONG_MAX, 9, 4);  /* bad constant */
+  MPFR_ASSERTN (mpfr_const_cache_load (FILE_NAME_2) != 0);
+  check_loaded ();
+
+  /* nothing is done if the MPFR_CONST_CACHE_FILE variable is not set */
+  if (getenv ("MPFR_CONST_CACHE_FILE") == NULL)
+    MPFR_ASSERTN (mpfr_const_cache_load (NULL) == 0);
+
+  remove (FILE_NAME);
+  remove (FILE_NAME_2);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_save_load ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,221 @@
+/* Test file for mpfr_ctx_init, mpfr_ctx_save, mpfr_ctx_load and
+   mpfr_ctx_swap.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+/* check that the state of the current thread is the one of ctx */
+static void
+check_state (mpfr_ctx_t ctx, const char *s)
+{
+  if (mpfr_flags_save () != ctx->_mpfr_flags ||
+      mpfr_get_emin () != ctx->_mpfr_emin ||
+      mpfr_get_emax () != ctx->_mpfr_emax ||
+      mpfr_get_default_prec () != ctx->_mpfr_prec ||
+      mpfr_get_default_rounding_mode () != ctx->_mpfr_rnd)
+    {
+      printf ("Error in %s: wrong state\n", s);
+      printf ("flags = %u, expected %u\n", (unsigned int) mpfr_flags_save (),
+              (unsigned int) ctx->_mpfr_flags);
+      printf ("emin = %" MPFR_EXP_FSPEC "d, expected %" MPFR_EXP_FSPEC "d\n",
+              (mpfr_eexp_t) mpfr_get_emin (), (mpfr_eexp_t) ctx->_mpfr_emin);
+      printf ("emax = %" MPFR_EXP_FSPEC "d, expected %" MPFR_EXP_FSPEC "d\n",
+              (mpfr_eexp_t) mpfr_get_emax (), (mpfr_eexp_t) ctx->_mpfr_emax);
+      printf ("prec = %lu, expected %lu\n",
+              (unsigned long) mpfr_get_default_prec (),
+              (unsigned long) ctx->_mpfr_prec);
+      printf ("rnd = %s, expected %s\n",
+              mpfr_print_rnd_mode (mpfr_get_default_rounding_mode ()),
+              mpfr_print_rnd_mode ((mpfr_rnd_t) ctx->_mpfr_rnd));
+      exit (1);
+    }
+}
+
+static void
+check_init (void)
+{
+  mpfr_ctx_t old, ctx;
+
+  mpfr_ctx_save (old);
+  mpfr_ctx_init (ctx);
+  MPFR_ASSERTN (ctx->_mpfr_flags == 0);
+  MPFR_ASSERTN (ctx->_mpfr_emin == MPFR_EMIN_DEFAULT);
+  MPFR_ASSERTN (ctx->_mpfr_emax == MPFR_EMAX_DEFAULT);
+  MPFR_ASSERTN (ctx->_mpfr_prec == 53);
+  MPFR_ASSERTN (ctx->_mpfr_rnd == MPFR_RNDN);
+
+  mpfr_ctx_load (ctx);
+  check_state (ctx, "check_init (load)");
+  mpfr_ctx_load (old);
+  check_state (old, "check_init (restore)");
+}
+
+static void
+check_save_load (void)
+{
+  mpfr_ctx_t old, ctx;
+
+  mpfr_ctx_save (old);
+  mpfr_set_emin (-17);
+  mpfr_set_emax (42);
+  mpfr_set_default_prec (100);
+  mpfr_set_default_rounding_mode (MPFR_RNDZ);
+  mpfr_flags_clear (MPFR_FLAGS_ALL);
+  mpfr_flags_set (MPFR_FLAGS_OVERFLOW | MPFR_FLAGS_DIVBY0);
+  mpfr_ctx_save (ctx);
+  MPFR_ASSERTN (ctx->_mpfr_flags == (MPFR_FLAGS_OVERFLOW | MPFR_FLAGS_DIVBY0));
+  MPFR_ASSERTN (ctx->_mpfr_emin == -17);
+  MPFR_ASSERTN (ctx->_mpfr_emax == 42);
+  MPFR_ASSERTN (ctx->_mpfr_prec == 100);
+  MPFR_ASSERTN (ctx->_mpfr_rnd == MPFR_RNDZ);
+
+  mpfr_ctx_load (old);
+  check_state (old, "check_save_load (restore)");
+  mpfr_ctx_load (ctx);
+  check_state (ctx, "check_save_load (load)");
+  mpfr_ctx_load (old);
+}
+
+/* Two computations interleaved on the same thread, each one with its own
+   context, must give the same results and flags as when they are done
+   separately. */
+static void
+check_swap (void)
+{
+  mpfr_ctx_t old, a, b, a0, b0;
+  mpfr_t x, y;
+  int inex;
+
+  mpfr_ctx_save (old);
+  mpfr_init2 (x, 17);
+  mpfr_init2 (y, 17);
+
+  /* a: small exponent range; b: directed rounding by default */
+  mpfr_ctx_init (a);
+  a->_mpfr_emax = 10;
+  mpfr_ctx_init (b);
+  b->_mpfr_rnd = MPFR_RNDU;
+  b->_mpfr_prec = 20;
+  *a0 = *a;
+  *b0 = *b;
+
+  mpfr_ctx_swap (a);
+  /* now a contains the state of the thread */
+  check_state (a0, "check_swap (resume a)");
+  inex = mpfr_set_ui_2exp (x, 1, 20, MPFR_RNDN);
+  MPFR_ASSERTN (inex > 0 && mpfr_inf_p (x));
+  mpfr_ctx_swap (a);
+  check_state (old, "check_swap (suspend a)");
+  MPFR_ASSERTN (a->_mpfr_flags == (MPFR_FLAGS_OVERFLOW | MPFR_FLAGS_INEXACT));
+
+  mpfr_ctx_swap (b);
+  check_state (b0, "check_swap (resume b)");
+  mpfr_set_ui (x, 1, mpfr_get_default_rounding_mode ());
+  mpfr_div_ui (x, x, 3, mpfr_get_default_rounding_mode ());
+  mpfr_ctx_swap (b);
+  check_state (old, "check_swap (suspend b)");
+  MPFR_ASSERTN (b->_mpfr_flags == MPFR_FLAGS_INEXACT);
+
+  mpfr_ctx_swap (a);
+  MPFR_ASSERTN (mpfr_get_emax () == 10);
+  mpfr_set_ui (y, 1, MPFR_RNDN);
+  mpfr_ctx_swap (a);
+  MPFR_ASSERTN (a->_mpfr_flags == (MPFR_FLAGS_OVERFLOW | MPFR_FLAGS_INEXACT));
+  check_state (old, "check_swap (end)");
+
+  /* the default rounding mode of b is upward */
+  mpfr_set_ui (y, 1, MPFR_RNDN);
+  mpfr_div_ui (y, y, 3, MPFR_RNDU);
+  MPFR_ASSERTN (mpfr_equal_p (x, y));
+  mpfr_ctx_load (old);
+
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+#if defined(MPFR_USE_THREAD_SAFE) && defined(HAVE_PTHREAD)
+
+# include <pthread.h>
+
+/* Each thread resumes the computation in the context, squares the number
+   in the reduced exponent range, and suspends it. */
+static void *
+start_routine (void *arg)
+{
+  __mpfr_ctx_struct *ctx = (__mpfr_ctx_struct *) ((void **) arg)[0];
+  mpfr_ptr x = (mpfr_ptr) ((void **) arg)[1];
+
+  mpfr_ctx_swap (ctx);
+  MPFR_ASSERTN (mpfr_get_emax () == 64);
+  mpfr_sqr (x, x, MPFR_RNDN);
+  mpfr_ctx_swap (ctx);
+  pthread_exit (NULL);
+}
+
+static void
+check_threads (void)
+{
+  mpfr_ctx_t ctx;
+  mpfr_t x;
+  void *arg[2];
+  pthread_t thread_id;
+  int i, error_code;
+
+  mpfr_ctx_init (ctx);
+  ctx->_mpfr_emax = 64;
+  mpfr_init2 (x, 53);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  arg[0] = ctx;
+  arg[1] = x;
+  for (i = 0; i < 6; i++)
+    {
+      error_code = pthread_create (&thread_id, NULL, start_routine, arg);
+      MPFR_ASSERTN (error_code == 0);
+      error_code = pthread_join (thread_id, NULL);
+      MPFR_ASSERTN (error_code == 0);
+      /* 3^32 is still exact on 53 bits */
+      MPFR_ASSERTN (ctx->_mpfr_flags == (i < 5 ? 0 :
+                                         MPFR_FLAGS_OVERFLOW |
+                                         MPFR_FLAGS_INEXACT));
+    }
+  /* 3^64 overflows in the exponent range of ctx */
+  MPFR_ASSERTN (mpfr_inf_p (x) && MPFR_IS_POS (x));
+  mpfr_clear (x);
+}
+
+#else
+
+# define check_threads() ((void) 0)
+
+#endif
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_init ();
+  check_save_load ();
+  check_swap ();
+  check_threads ();
+
+  tests_end_mpfr ();
+  return 0;
+}
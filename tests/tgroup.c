@@ -0,0 +1,177 @@
+/* Test file for mpfr_group_init2, mpfr_group_set_prec, mpfr_group_clear
+   and mpfr_group_get_size.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static void
+heap_stats (size_t *bytes, unsigned long *allocs)
+{
+  mpfr_memory_stats_t s;
+
+  mpfr_get_memory_stats (&s);
+  *bytes = s.heap_bytes;
+  *allocs = s.heap_allocs;
+}
+
+/* Compute a few values with the variables of the group, and compare them
+   with ordinary variables. */
+static void
+check_values (mpfr_ptr a, mpfr_ptr b, mpfr_ptr c)
+{
+  mpfr_t u, v, w;
+  mpfr_prec_t p = mpfr_get_prec (a);
+
+  MPFR_ASSERTN (mpfr_nan_p (a) && mpfr_nan_p (b) && mpfr_nan_p (c));
+  MPFR_ASSERTN (mpfr_get_prec (b) == p && mpfr_get_prec (c) == p);
+  mpfr_inits2 (p, u, v, w, (mpfr_ptr) 0);
+  mpfr_set_ui (a, 2, MPFR_RNDN);
+  mpfr_sqrt (b, a, MPFR_RNDN);
+  mpfr_exp (c, b, MPFR_RNDN);
+  mpfr_set_ui (u, 2, MPFR_RNDN);
+  mpfr_sqrt (v, u, MPFR_RNDN);
+  mpfr_exp (w, v, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_equal_p (a, u) && mpfr_equal_p (b, v)
+                && mpfr_equal_p (c, w));
+  mpfr_clears (u, v, w, (mpfr_ptr) 0);
+}
+
+static void
+check_alloc (void)
+{
+  mpfr_group_t g;
+  mpfr_t a, b, c;
+  size_t bytes0, bytes;
+  unsigned long allocs0, allocs;
+
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_init2 (g, NULL, 0, 1000, a, b, c, (mpfr_ptr) 0);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0 + 1);
+  MPFR_ASSERTN (bytes == bytes0 + mpfr_group_get_size (1000, 3));
+  check_values (a, b, c);
+
+  /* a smaller precision does not need any allocation */
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_set_prec (g, 500);
+  mpfr_group_set_prec (g, 1000);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0);
+  check_values (a, b, c);
+
+  /* a larger one needs a single one */
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_set_prec (g, 3000);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0 + 1);
+  MPFR_ASSERTN (bytes == bytes0 + mpfr_group_get_size (3000, 3)
+                - mpfr_group_get_size (1000, 3));
+  check_values (a, b, c);
+
+  /* a variable of the group can become an ordinary one */
+  heap_stats (&bytes0, &allocs0);
+  mpfr_set_prec (b, 10000);
+  mpfr_set_ui (b, 3, MPFR_RNDN);
+  mpfr_prec_round (a, 20000, MPFR_RNDN);
+  mpfr_group_set_prec (g, 100);
+  check_values (a, b, c);
+  mpfr_set_prec (c, 5000);
+  mpfr_swap (a, b);
+
+  mpfr_group_clear (g);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (bytes == bytes0 - mpfr_group_get_size (3000, 3));
+}
+
+static void
+check_buffer (void)
+{
+  union { mp_limb_t l[256]; void *p; } buf;
+  mpfr_group_t g;
+  mpfr_t x[6];
+  size_t bytes0, bytes;
+  unsigned long allocs0, allocs;
+  mpfr_prec_t p;
+  int i;
+
+  MPFR_ASSERTN (mpfr_group_get_size (100, 6) <= sizeof (buf));
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_init2 (g, &buf, sizeof (buf), 100,
+                    x[0], x[1], x[2], x[3], x[4], x[5], (mpfr_ptr) 0);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0 && bytes == bytes0);
+  check_values (x[0], x[3], x[5]);
+  for (i = 0; i < 6; i++)
+    mpfr_set_si (x[i], i - 3, MPFR_RNDN);
+  for (i = 0; i < 6; i++)
+    MPFR_ASSERTN (mpfr_cmp_si (x[i], i - 3) == 0);
+  mpfr_swap (x[1], x[2]);
+  MPFR_ASSERTN (mpfr_cmp_si (x[1], -1) == 0 && mpfr_cmp_si (x[2], -2) == 0);
+
+  /* the largest precision for which the buffer is large enough */
+  for (p = 100; mpfr_group_get_size (p + 1, 6) <= sizeof (buf); p++)
+    ;
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_set_prec (g, p);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0 && bytes == bytes0);
+  check_values (x[1], x[2], x[4]);
+
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_set_prec (g, p + 1);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0 + 1);
+  check_values (x[1], x[2], x[4]);
+  bytes0 = bytes - mpfr_group_get_size (p + 1, 6);
+
+  mpfr_group_clear (g);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (bytes == bytes0);
+}
+
+static void
+check_empty (void)
+{
+  mpfr_group_t g;
+  size_t bytes0, bytes;
+  unsigned long allocs0, allocs;
+
+  MPFR_ASSERTN (mpfr_group_get_size (MPFR_PREC_MIN, 0) == 0);
+  heap_stats (&bytes0, &allocs0);
+  mpfr_group_init2 (g, NULL, 0, 53, (mpfr_ptr) 0);
+  mpfr_group_set_prec (g, 1000);
+  mpfr_group_clear (g);
+  heap_stats (&bytes, &allocs);
+  MPFR_ASSERTN (allocs == allocs0 && bytes == bytes0);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_alloc ();
+  check_buffer ();
+  check_empty ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,178 @@
+/* Test file for mpfr_get_memory_stats and mpfr_set_memory_hook.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static void
+check_heap (void)
+{
+  mpfr_memory_stats_t s0, s1;
+  mpfr_t x;
+
+  mpfr_get_memory_stats (&s0);
+  MPFR_ASSERTN (s0.heap_peak >= s0.heap_bytes);
+
+  mpfr_init2 (x, 10000);
+  mpfr_get_memory_stats (&s1);
+  MPFR_ASSERTN (s1.heap_bytes >= s0.heap_bytes + 10000 / CHAR_BIT);
+  MPFR_ASSERTN (s1.heap_peak >= s1.heap_bytes);
+  MPFR_ASSERTN (s1.heap_allocs == s0.heap_allocs + 1);
+
+  mpfr_set_prec (x, 20000);
+  mpfr_get_memory_stats (&s1);
+  MPFR_ASSERTN (s1.heap_bytes >= s0.heap_bytes + 20000 / CHAR_BIT);
+  MPFR_ASSERTN (s1.heap_allocs == s0.heap_allocs + 2);
+
+  mpfr_clear (x);
+  mpfr_get_memory_stats (&s1);
+  MPFR_ASSERTN (s1.heap_bytes == s0.heap_bytes);
+  MPFR_ASSERTN (s1.heap_peak >= s0.heap_bytes + 20000 / CHAR_BIT);
+}
+
+static unsigned long nhook;
+static size_t hook_bytes;
+static void *hook_ptr;
+
+static void
+hook (void *old_ptr, size_t old_size, void *new_ptr, size_t new_size)
+{
+  nhook++;
+  /* a block is either allocated, reallocated or freed */
+  MPFR_ASSERTN ((old_ptr == NULL) == (old_size == 0));
+  MPFR_ASSERTN ((new_ptr == NULL) == (new_size == 0));
+  MPFR_ASSERTN (old_ptr != NULL || new_ptr != NULL);
+  MPFR_ASSERTN (old_ptr == NULL || old_ptr == hook_ptr);
+  hook_bytes += new_size - old_size;
+  hook_ptr = new_ptr;
+}
+
+static void
+check_hook (void)
+{
+  mpfr_t x;
+
+  MPFR_ASSERTN (mpfr_set_memory_hook (hook) == NULL);
+  mpfr_init2 (x, 1000);
+  MPFR_ASSERTN (nhook == 1 && hook_bytes >= 1000 / CHAR_BIT);
+  MPFR_ASSERTN (hook_ptr != NULL);
+  mpfr_set_prec (x, 5000);
+  MPFR_ASSERTN (nhook == 2 && hook_bytes >= 5000 / CHAR_BIT);
+  mpfr_clear (x);
+  MPFR_ASSERTN (nhook == 3 && hook_bytes == 0 && hook_ptr == NULL);
+  MPFR_ASSERTN (mpfr_set_memory_hook (NULL) == hook);
+
+  mpfr_init2 (x, 1000);
+  mpfr_clear (x);
+  MPFR_ASSERTN (nhook == 3);
+}
+
+/* The temporary memory allocated with alloca is counted only with the
+   MPFR implementation of MPFR_TMP_ALLOC. */
+static void
+check_stack (void)
+{
+#if !defined(MPFR_HAVE_GMP_IMPL) && MPFR_ALLOCA_MAX != 0
+  mpfr_memory_stats_t s;
+  mpfr_t x, y;
+
+  mpfr_inits2 (1000, x, y, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 17, MPFR_RNDN);
+  mpfr_sqrt (x, x, MPFR_RNDN);
+  mpfr_sin (y, x, MPFR_RNDN);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.stack_peak >= 1000 / CHAR_BIT);
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+#endif
+}
+
+static void
+check_caches (void)
+{
+  mpfr_memory_stats_t s;
+  mpfr_t x;
+
+  mpfr_free_cache ();
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.cache_bytes == 0 && s.pool_bytes == 0);
+
+  mpfr_init2 (x, 10000);
+  mpfr_const_pi (x, MPFR_RNDN);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.cache_bytes >= 10000 / CHAR_BIT);
+  MPFR_ASSERTN (s.pool_hits + s.pool_misses > 0);
+
+  mpfr_free_cache ();
+  mpfr_set_prec (x, 100);
+  mpfr_set_ui (x, 1000, MPFR_RNDN);
+  mpfr_gamma (x, x, MPFR_RNDN);  /* uses the Bernoulli numbers */
+  MPFR_ASSERTN (mpfr_bernoulli_cache_bytes () > 0);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.cache_bytes >= mpfr_bernoulli_cache_bytes ());
+  mpfr_clear (x);
+
+  mpfr_free_cache ();
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.cache_bytes == 0 && s.pool_bytes == 0);
+}
+
+static void
+check_arena (void)
+{
+  mpfr_memory_stats_t s;
+  mpfr_t x, y;
+
+  mpfr_inits2 (5000, x, y, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.arena_size == 0 && s.arena_peak == 0);
+  MPFR_ASSERTN (s.arena_misses == 0);
+
+  MPFR_ASSERTN (mpfr_set_arena_size (1 << 18) == 0);
+  mpfr_log (y, x, MPFR_RNDN);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.arena_size == mpfr_get_arena_size ());
+  MPFR_ASSERTN (s.arena_peak > 0 && s.arena_peak <= s.arena_size);
+
+  /* a too small arena */
+  MPFR_ASSERTN (mpfr_set_arena_size (256) == 0);
+  mpfr_log (y, x, MPFR_RNDN);
+  mpfr_get_memory_stats (&s);
+  MPFR_ASSERTN (s.arena_misses > 0);
+
+  MPFR_ASSERTN (mpfr_set_arena_size (0) == 0);
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_heap ();
+  check_hook ();
+  check_stack ();
+  check_caches ();
+  check_arena ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -1296,6 +1296,51 @@ coverage2 (void)
   set_emin (emin); /* restore emin */
 }
 
+/* Check the products of operands having trailing zero limbs, which are
+   skipped: the results must be the same as with the same values in a
+   small precision. */
+static void
+check_sparse (void)
+{
+  mpfr_t x, y, x1, y1, a1, a2;
+  mpfr_prec_t q;
+  int i, r, inex1, inex2;
+
+  mpfr_inits2 (1000, x1, y1, a1, a2, (mpfr_ptr) 0);
+  for (i = 0; i < 200; i++)
+    {
+      q = 1 + randlimb () % 200;
+      mpfr_init2 (x, q);
+      mpfr_init2 (y, (randlimb () & 1) ? q : 1 + randlimb () % 3000);
+      mpfr_set_prec (x1, 4 * q + randlimb () % 3000);
+      mpfr_set_prec (y1, mpfr_get_prec (y) + randlimb () % 3000);
+      mpfr_set_prec (a1, 1 + randlimb () % 3000);
+      mpfr_set_prec (a2, mpfr_get_prec (a1));
+      mpfr_urandomb (x, RANDS);
+      mpfr_urandomb (y, RANDS);
+      mpfr_set (x1, x, MPFR_RNDN);  /* exact */
+      mpfr_set (y1, y, MPFR_RNDN);
+      RND_LOOP (r)
+        {
+          inex1 = mpfr_mul (a1, x1, y1, (mpfr_rnd_t) r);
+          inex2 = mpfr_mul (a2, x, y, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              printf ("x1 = ");
+              mpfr_dump (x1);
+              printf ("y1 = ");
+              mpfr_dump (y1);
+              exit (1);
+            }
+        }
+      mpfr_clear (x);
+      mpfr_clear (y);
+    }
+  mpfr_clears (x1, y1, a1, a2, (mpfr_ptr) 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1352,6 +1397,7 @@ main (int argc, char *argv[])
   bug20161209a ();
   bug20170602 ();
   test_underflow2 ();
+  check_sparse ();
 
   tests_end_mpfr ();
   return 0;
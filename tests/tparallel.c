@@ -0,0 +1,394 @@
+/* Test file for the parallel mode: mpfr_set_num_threads,
+   mpfr_get_num_threads, mpfr_set_speculation, mpfr_get_speculation, and
+   the functions using several threads.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static void
+check_num_threads (void)
+{
+  int r;
+
+  if (mpfr_get_num_threads () != 1)
+    {
+      printf ("Error, the default number of threads is %u\n",
+              mpfr_get_num_threads ());
+      exit (1);
+    }
+
+  r = mpfr_set_num_threads (0);
+  if (r != 0 || mpfr_get_num_threads () != 1)
+    {
+      printf ("Error in mpfr_set_num_threads (0): r = %d, %u threads\n",
+              r, mpfr_get_num_threads ());
+      exit (1);
+    }
+
+  r = mpfr_set_num_threads (3);
+  if (! mpfr_buildopt_parallel_p ())
+    {
+      if (r == 0 || mpfr_get_num_threads () != 1)
+        {
+          printf ("Error in mpfr_set_num_threads (3) without parallel "
+                  "mode: r = %d, %u threads\n", r, mpfr_get_num_threads ());
+          exit (1);
+        }
+    }
+  else if (r == 0 && mpfr_get_num_threads () != 3)
+    {
+      printf ("Error in mpfr_set_num_threads (3): %u threads\n",
+              mpfr_get_num_threads ());
+      exit (1);
+    }
+
+  mpfr_set_num_threads (1);
+  if (mpfr_get_num_threads () != 1)
+    {
+      printf ("Error in mpfr_set_num_threads (1): %u threads\n",
+              mpfr_get_num_threads ());
+      exit (1);
+    }
+}
+
+/* Check that f gives the same result with 1 and n threads, in precision
+   p, the cache being freed before each computation. */
+static void
+check_const (int (*f) (mpfr_ptr, mpfr_rnd_t), const char *s,
+             mpfr_prec_t p, unsigned int n)
+{
+  mpfr_t x, y;
+  int inex1, inex2;
+  int r;
+
+  mpfr_inits2 (p, x, y, (mpfr_ptr) 0);
+
+  mpfr_free_cache ();
+  inex1 = f (x, MPFR_RNDN);
+
+  mpfr_free_cache ();
+  r = mpfr_set_num_threads (n);
+  if (r != 0 && mpfr_buildopt_parallel_p ())
+    printf ("Warning: only %u threads could be created\n",
+            mpfr_get_num_threads ());
+  inex2 = f (y, MPFR_RNDN);
+  mpfr_set_num_threads (1);
+
+  if (! mpfr_equal_p (x, y) || ! SAME_SIGN (inex1, inex2))
+    {
+      printf ("Error in %s with %u threads, precision %lu\n", s, n,
+              (unsigned long) p);
+      printf ("expected ");
+      mpfr_dump (x);
+      printf ("got      ");
+      mpfr_dump (y);
+      printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+      exit (1);
+    }
+
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+/* Check that mpfr_exp_3 and mpfr_sincos_fast give the same results and
+   flags with 1 and n threads on random inputs in precision p. */
+static void
+check_series (mpfr_prec_t p, unsigned int n)
+{
+  mpfr_t x, y1, y2, z1, z2;
+  mpfr_flags_t flags1, flags2;
+  int inex1, inex2, i;
+
+  mpfr_init2 (x, p);
+  mpfr_inits2 (p, y1, y2, z1, z2, (mpfr_ptr) 0);
+
+  for (i = 0; i < 4; i++)
+    {
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, (i & 1) ? 3 : -1, MPFR_RNDN);
+      if (i & 2)
+        mpfr_neg (x, x, MPFR_RNDN);
+
+      mpfr_clear_flags ();
+      inex1 = mpfr_exp_3 (y1, x, MPFR_RNDN);
+      flags1 = __gmpfr_flags;
+      mpfr_set_num_threads (n);
+      mpfr_clear_flags ();
+      inex2 = mpfr_exp_3 (y2, x, MPFR_RNDN);
+      flags2 = __gmpfr_flags;
+      mpfr_set_num_threads (1);
+      if (! mpfr_equal_p (y1, y2) || ! SAME_SIGN (inex1, inex2) ||
+          flags1 != flags2)
+        {
+          printf ("Error in mpfr_exp_3 with %u threads, precision %lu\n",
+                  n, (unsigned long) p);
+          printf ("x = ");
+          mpfr_dump (x);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          flags_out (flags1);
+          flags_out (flags2);
+          exit (1);
+        }
+
+      mpfr_clear_flags ();
+      inex1 = mpfr_sincos_fast (y1, z1, x, MPFR_RNDN);
+      flags1 = __gmpfr_flags;
+      mpfr_set_num_threads (n);
+      mpfr_clear_flags ();
+      inex2 = mpfr_sincos_fast (y2, z2, x, MPFR_RNDN);
+      flags2 = __gmpfr_flags;
+      mpfr_set_num_threads (1);
+      if (! mpfr_equal_p (y1, y2) || ! mpfr_equal_p (z1, z2) ||
+          inex1 != inex2 || flags1 != flags2)
+        {
+          printf ("Error in mpfr_sincos_fast with %u threads, "
+                  "precision %lu\n", n, (unsigned long) p);
+          printf ("x = ");
+          mpfr_dump (x);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          flags_out (flags1);
+          flags_out (flags2);
+          exit (1);
+        }
+    }
+
+  mpfr_clears (x, y1, y2, z1, z2, (mpfr_ptr) 0);
+}
+
+/* Check that mpfr_sum gives the same results and flags with 1 and n
+   threads on nb random inputs of various precisions and exponents. The
+   last c inputs (with c <= nb/2) are the opposite of other ones, so that
+   there is a large cancellation, or an exact zero if nb = 2c. The custom
+   interface is used to allocate all the significands in a single block,
+   as many blocks would make the memory checking of the tests slow. */
+#define SUM_PREC_MAX 200
+static void
+check_sum (unsigned long nb, unsigned long c, unsigned int n)
+{
+  mpfr_t *t, s1, s2;
+  mpfr_ptr *p;
+  mpfr_prec_t prec;
+  mpfr_flags_t flags1, flags2;
+  char *m;
+  size_t size;
+  unsigned long i;
+  int inex1, inex2, r;
+
+  size = mpfr_custom_get_size (SUM_PREC_MAX);
+  t = (mpfr_t *) tests_allocate (nb * sizeof (mpfr_t));
+  p = (mpfr_ptr *) tests_allocate (nb * sizeof (mpfr_ptr));
+  m = (char *) tests_allocate (nb * size);
+  for (i = 0; i < nb; i++)
+    {
+      prec = i >= nb - c ? mpfr_get_prec (t[i - nb / 2]) :
+        MPFR_PREC_MIN + randlimb () % (SUM_PREC_MAX - MPFR_PREC_MIN + 1);
+      mpfr_custom_init (m + i * size, prec);
+      mpfr_custom_init_set (t[i], MPFR_ZERO_KIND, 0, prec, m + i * size);
+      if (i >= nb - c)
+        mpfr_neg (t[i], t[i - nb / 2], MPFR_RNDN);  /* exact */
+      else if (randlimb () % 8 == 0)
+        mpfr_set_zero (t[i], randlimb () % 2 ? 1 : -1);
+      else
+        {
+          mpfr_urandomb (t[i], RANDS);
+          mpfr_mul_2si (t[i], t[i], (long) (randlimb () % 200) - 100,
+                        MPFR_RNDN);
+          if (randlimb () % 2)
+            mpfr_neg (t[i], t[i], MPFR_RNDN);
+        }
+      p[i] = t[i];
+    }
+  mpfr_inits2 (100, s1, s2, (mpfr_ptr) 0);
+
+  RND_LOOP (r)
+    {
+      mpfr_clear_flags ();
+      inex1 = mpfr_sum (s1, p, nb, (mpfr_rnd_t) r);
+      flags1 = __gmpfr_flags;
+      mpfr_set_num_threads (n);
+      mpfr_clear_flags ();
+      inex2 = mpfr_sum (s2, p, nb, (mpfr_rnd_t) r);
+      flags2 = __gmpfr_flags;
+      mpfr_set_num_threads (1);
+      if (! mpfr_equal_p (s1, s2) || MPFR_SIGN (s1) != MPFR_SIGN (s2) ||
+          inex1 != inex2 || flags1 != flags2)
+        {
+          printf ("Error in mpfr_sum with %u threads, nb = %lu, c = %lu, "
+                  "%s\n", n, nb, c, mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+          printf ("expected ");
+          mpfr_dump (s1);
+          printf ("got      ");
+          mpfr_dump (s2);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          flags_out (flags1);
+          flags_out (flags2);
+          exit (1);
+        }
+    }
+
+  tests_free (t, nb * sizeof (mpfr_t));
+  tests_free (p, nb * sizeof (mpfr_ptr));
+  tests_free (m, nb * size);
+  mpfr_clears (s1, s2, (mpfr_ptr) 0);
+}
+
+/* Check f on x in precision p, with the speculation enabled and n threads
+   against the result without it, for all the rounding modes. */
+static void
+check_speculation1 (int (*f) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t),
+                    const char *s, mpfr_srcptr x, mpfr_prec_t p,
+                    unsigned int n)
+{
+  mpfr_t y1, y2;
+  mpfr_flags_t flags1, flags2;
+  int inex1, inex2, r;
+
+  mpfr_inits2 (p, y1, y2, (mpfr_ptr) 0);
+  RND_LOOP (r)
+    {
+      mpfr_rnd_t rnd = (mpfr_rnd_t) r;
+
+      mpfr_clear_flags ();
+      inex1 = f (y1, x, rnd);
+      flags1 = __gmpfr_flags;
+      mpfr_set_num_threads (n);
+      mpfr_set_speculation (1);
+      mpfr_clear_flags ();
+      inex2 = f (y2, x, rnd);
+      flags2 = __gmpfr_flags;
+      mpfr_set_speculation (0);
+      mpfr_set_num_threads (1);
+      if (! (mpfr_equal_p (y1, y2) || (mpfr_nan_p (y1) && mpfr_nan_p (y2)))
+          || ! SAME_SIGN (inex1, inex2) || flags1 != flags2)
+        {
+          printf ("Error in %s with speculation, %u threads, precision %lu,"
+                  " %s\n", s, n, (unsigned long) p,
+                  mpfr_print_rnd_mode (rnd));
+          printf ("x = ");
+          mpfr_dump (x);
+          printf ("expected ");
+          mpfr_dump (y1);
+          printf ("got      ");
+          mpfr_dump (y2);
+          printf ("inex1 = %d, inex2 = %d\n", inex1, inex2);
+          flags_out (flags1);
+          flags_out (flags2);
+          exit (1);
+        }
+    }
+  mpfr_clears (y1, y2, (mpfr_ptr) 0);
+}
+
+/* Check the speculative evaluation of mpfr_exp, mpfr_log, mpfr_gamma,
+   mpfr_zeta and mpfr_erf in precision p, on random inputs and on inputs
+   for which mpfr_exp and mpfr_log are hard to round (when the attempt in
+   the larger precision should win), and with a reduced exponent range
+   (when it cannot be used). */
+static void
+check_speculation (mpfr_prec_t p, unsigned int n)
+{
+  mpfr_exp_t emax;
+  mpfr_t x, z;
+  int i, r;
+
+  r = mpfr_set_speculation (1);
+  if (mpfr_buildopt_parallel_p () ? r != 0 || ! mpfr_get_speculation ()
+      : r == 0 || mpfr_get_speculation ())
+    {
+      printf ("Error in mpfr_set_speculation (1): r = %d\n", r);
+      exit (1);
+    }
+  r = mpfr_set_speculation (0);
+  if (r != 0 || mpfr_get_speculation ())
+    {
+      printf ("Error in mpfr_set_speculation (0): r = %d\n", r);
+      exit (1);
+    }
+
+  mpfr_init2 (x, p + 40);
+  mpfr_init2 (z, p + 1);
+
+  for (i = 0; i < 2; i++)
+    {
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_2si (x, x, i ? 4 : 0, MPFR_RNDN);
+      check_speculation1 (mpfr_exp, "mpfr_exp", x, p, n);
+      check_speculation1 (mpfr_log, "mpfr_log", x, p, n);
+      check_speculation1 (mpfr_gamma, "mpfr_gamma", x, p, n);
+      check_speculation1 (mpfr_zeta, "mpfr_zeta", x, p, n);
+      check_speculation1 (mpfr_erf, "mpfr_erf", x, p, n);
+    }
+
+  /* exp(log(z)) and log(exp(z)) are close to z, which is a breakpoint in
+     precision p, at about 2^(-40) ulp. */
+  for (i = 0; i < 2; i++)
+    {
+      mpfr_urandomb (z, RANDS);
+      mpfr_add_ui (z, z, 1, MPFR_RNDN);
+      if (i)
+        mpfr_prec_round (z, p, MPFR_RNDN);
+      mpfr_log (x, z, MPFR_RNDN);
+      check_speculation1 (mpfr_exp, "mpfr_exp", x, p, n);
+      mpfr_exp (x, z, MPFR_RNDN);
+      check_speculation1 (mpfr_log, "mpfr_log", x, p, n);
+      mpfr_prec_round (z, p + 1, MPFR_RNDN);
+    }
+
+  emax = mpfr_get_emax ();
+  set_emax (1);  /* gamma(x) > 2 overflows */
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  mpfr_nextabove (x);
+  check_speculation1 (mpfr_exp, "mpfr_exp", x, p, n);
+  check_speculation1 (mpfr_gamma, "mpfr_gamma", x, p, n);
+  set_emax (emax);
+
+  mpfr_clears (x, z, (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  unsigned int n;
+
+  tests_start_mpfr ();
+
+  check_num_threads ();
+
+  /* The precisions are chosen so that the binary splitting has more than
+     MPFR_BS_PARALLEL_THRESHOLD terms, and that the working precision of
+     mpfr_exp_3 and mpfr_sincos_fast is larger than
+     MPFR_PREC_PARALLEL_THRESHOLD, and that the number of inputs of mpfr_sum
+     is larger than MPFR_SUM_PARALLEL_THRESHOLD, and that the speculative
+     evaluation is done (MPFR_SPEC_PARALLEL_THRESHOLD), with their default
+     values. */
+  for (n = 2; n <= 4; n++)
+    {
+      check_const (mpfr_const_log2, "mpfr_const_log2", 30000, n);
+      check_const (mpfr_const_catalan, "mpfr_const_catalan", 30000, n);
+      check_const (mpfr_const_euler, "mpfr_const_euler", 30000, n);
+      check_series (20000, n);
+      check_sum (30001, 7500, n);
+      check_sum (30000, 15000, n);
+      check_speculation (1100, n);
+    }
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* Test file for the internal mpz_t pool.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#if MPFR_POOL_NENTRIES
+
+#define LIMBS(n) ((mp_bitcnt_t) (n) * GMP_NUMB_BITS)
+
+/* Check that the sizes are taken into account. */
+static void
+check_classes (void)
+{
+  mpz_t a, b, c, d;
+  mp_limb_t *pa, *pb, *pc;
+  mpfr_pool_stats_t s0, s1;
+
+  mpfr_free_pool ();
+  mpfr_pool_stats (&s0);
+  MPFR_ASSERTN (s0.bytes == 0);
+
+  mpfr_mpz_init2 (a, LIMBS (1));
+  mpfr_mpz_init2 (b, LIMBS (100));
+  mpfr_mpz_init2 (c, LIMBS (10));
+  pa = PTR (a);
+  pb = PTR (b);
+  pc = PTR (c);
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.misses == s0.misses + 3 && s1.hits == s0.hits);
+  /* the large one is freed first, so that it is at the bottom */
+  mpfr_mpz_clear (b);
+  mpfr_mpz_clear (c);
+  mpfr_mpz_clear (a);
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.bytes == (size_t) (ALLOC (a) + ALLOC (b) + ALLOC (c))
+                * MPFR_BYTES_PER_MP_LIMB);
+
+  /* the smallest mpz_t large enough */
+  mpfr_mpz_init2 (b, LIMBS (50));
+  MPFR_ASSERTN (PTR (b) == pb);
+  mpfr_mpz_init2 (c, LIMBS (2));
+  MPFR_ASSERTN (PTR (c) == pc);
+  mpfr_mpz_clear (c);
+  mpfr_mpz_clear (b);
+
+  /* the largest mpz_t without size */
+  mpfr_mpz_init (b);
+  MPFR_ASSERTN (PTR (b) == pb && mpz_sgn (b) == 0);
+  mpfr_mpz_init (c);
+  MPFR_ASSERTN (PTR (c) == pc && mpz_sgn (c) == 0);
+  mpfr_mpz_init (a);
+  MPFR_ASSERTN (PTR (a) == pa && mpz_sgn (a) == 0);
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.hits == s0.hits + 5 && s1.misses == s0.misses + 3);
+  MPFR_ASSERTN (s1.bytes == 0);
+
+  /* the pool is empty */
+  mpfr_mpz_init2 (d, LIMBS (1));
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.misses == s0.misses + 4);
+  mpz_set_ui (b, 17);
+  mpz_mul_2exp (b, b, 1000);
+  mpz_set (c, b);
+  MPFR_ASSERTN (mpz_cmp (b, c) == 0);
+  mpfr_mpz_clear (a);
+  mpfr_mpz_clear (b);
+  mpfr_mpz_clear (c);
+  mpfr_mpz_clear (d);
+}
+
+/* Check the limits on the size of the pool. */
+static void
+check_limits (void)
+{
+  mpz_t z[MPFR_POOL_NENTRIES + 1];
+  mpfr_pool_stats_t s0, s1;
+  int i;
+
+  mpfr_free_pool ();
+  mpfr_pool_stats (&s0);
+
+  /* too large */
+  mpfr_mpz_init2 (z[0], (mp_bitcnt_t) MPFR_POOL_MAX_BYTES * CHAR_BIT + 1);
+  mpfr_mpz_clear (z[0]);
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.discards == s0.discards + 1 && s1.bytes == 0);
+
+  /* too many */
+  for (i = 0; i <= MPFR_POOL_NENTRIES; i++)
+    mpfr_mpz_init2 (z[i], LIMBS (1));
+  for (i = 0; i <= MPFR_POOL_NENTRIES; i++)
+    mpfr_mpz_clear (z[i]);
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.discards >= s0.discards + 2);
+  MPFR_ASSERTN (s1.bytes <= MPFR_POOL_MAX_BYTES);
+
+  mpfr_free_pool ();
+  mpfr_pool_stats (&s1);
+  MPFR_ASSERTN (s1.bytes == 0);
+}
+
+#endif
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+#if MPFR_POOL_NENTRIES
+  /* check_classes needs at least 3 entries with 111 limbs in total */
+  if (MPFR_POOL_NENTRIES >= 3 &&
+      MPFR_POOL_MAX_BYTES >= 111 * MPFR_BYTES_PER_MP_LIMB)
+    check_classes ();
+  check_limits ();
+#endif
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,125 @@
+/* Test file for mpfr_reserve_prec and mpfr_get_reserved_prec.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+static unsigned long
+heap_allocs (void)
+{
+  mpfr_memory_stats_t s;
+
+  mpfr_get_memory_stats (&s);
+  return s.heap_allocs;
+}
+
+static void
+check_reserve (void)
+{
+  mpfr_t x, y;
+  unsigned long n;
+
+  mpfr_inits2 (100, x, y, (mpfr_ptr) 0);
+  MPFR_ASSERTN (mpfr_get_reserved_prec (x) >= 100);
+  MPFR_ASSERTN (mpfr_get_reserved_prec (x) % GMP_NUMB_BITS == 0);
+  mpfr_const_pi (x, MPFR_RNDN);
+  mpfr_set (y, x, MPFR_RNDN);
+
+  /* the value and the precision are kept */
+  mpfr_reserve_prec (x, 10000);
+  MPFR_ASSERTN (mpfr_get_prec (x) == 100);
+  MPFR_ASSERTN (mpfr_get_reserved_prec (x) >= 10000);
+  MPFR_ASSERTN (mpfr_equal_p (x, y));
+
+  /* reserving less does nothing */
+  n = heap_allocs ();
+  mpfr_reserve_prec (x, 200);
+  MPFR_ASSERTN (mpfr_get_reserved_prec (x) >= 10000);
+
+  /* no reallocation up to the reserved precision */
+  mpfr_prec_round (x, 5000, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_equal_p (x, y));
+  mpfr_set_prec (x, 10000);
+  mpfr_set_ui (x, 7, MPFR_RNDN);
+  mpfr_set_prec_raw (x, mpfr_get_reserved_prec (x));
+  mpfr_set_prec (x, 100);
+  mpfr_set_prec (x, 9000);
+  MPFR_ASSERTN (heap_allocs () == n);
+
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+/* An embedded significand is replaced by an allocated one. */
+static void
+check_small (void)
+{
+  mpfr_small_t s;
+  mpfr_ptr x = mpfr_small_ptr (s);
+
+  mpfr_small_init2 (s, 64);
+  mpfr_set_ui (x, 17, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_get_reserved_prec (x) >= 64);
+  mpfr_reserve_prec (x, 1000);
+  MPFR_ASSERTN (mpfr_get_reserved_prec (x) >= 1000);
+  MPFR_ASSERTN (mpfr_get_prec (x) == 64 && mpfr_cmp_ui (x, 17) == 0);
+  mpfr_prec_round (x, 1000, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_cmp_ui (x, 17) == 0);
+  mpfr_clear (x);
+}
+
+/* When the precision grows by small increments, the number of
+   reallocations is logarithmic. */
+static void
+check_growth (void)
+{
+  mpfr_t x, y;
+  mpfr_prec_t p;
+  unsigned long n;
+
+  mpfr_inits2 (GMP_NUMB_BITS, x, y, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  n = heap_allocs ();
+  for (p = 2 * GMP_NUMB_BITS; p <= 1000 * GMP_NUMB_BITS; p += GMP_NUMB_BITS)
+    {
+      mpfr_prec_round (x, p, MPFR_RNDN);
+      MPFR_ASSERTN (mpfr_cmp_ui (x, 3) == 0);
+    }
+  MPFR_ASSERTN (heap_allocs () - n <= 20);
+
+  n = heap_allocs ();
+  for (p = 2 * GMP_NUMB_BITS; p <= 1000 * GMP_NUMB_BITS; p += GMP_NUMB_BITS)
+    mpfr_set_prec (y, p);
+  MPFR_ASSERTN (heap_allocs () - n <= 20);
+
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_reserve ();
+  check_small ();
+  check_growth ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,196 @@
+/* Test file for mpfr_small_init2.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define N 50
+
+#define IS_EMBEDDED(x) \
+  (MPFR_MANT (mpfr_small_ptr (x)) == (x)->_mpfr_d)
+
+/* Compare computations on an array of mpfr_small_t allocated on the heap
+   with the same computations on ordinary numbers. */
+static void
+check_array (mpfr_prec_t p)
+{
+  __mpfr_small_struct *a;
+  mpfr_t b[N], c;
+  int i, inex1, inex2;
+
+  a = (__mpfr_small_struct *) tests_allocate (N * sizeof (mpfr_small_t));
+  mpfr_init2 (c, p);
+  for (i = 0; i < N; i++)
+    {
+      mpfr_small_init2 (&a[i], p);
+      MPFR_ASSERTN (mpfr_get_prec (mpfr_small_ptr (&a[i])) == p);
+      MPFR_ASSERTN (mpfr_nan_p (mpfr_small_ptr (&a[i])));
+      MPFR_ASSERTN (IS_EMBEDDED (&a[i]) == (p <= MPFR_SMALL_PREC_MAX));
+      mpfr_init2 (b[i], p);
+      mpfr_urandomb (b[i], RANDS);
+      mpfr_add_ui (b[i], b[i], 1, MPFR_RNDN);
+      mpfr_set (mpfr_small_ptr (&a[i]), b[i], MPFR_RNDN);
+    }
+
+  /* a[i-1] and b[i-1] are not modified yet */
+  for (i = N - 1; i > 0; i--)
+    {
+      mpfr_ptr x = mpfr_small_ptr (&a[i]), y = mpfr_small_ptr (&a[i-1]);
+
+      inex1 = mpfr_mul (x, x, y, MPFR_RNDN);
+      inex2 = mpfr_mul (b[i], b[i], b[i-1], MPFR_RNDN);
+      MPFR_ASSERTN (inex1 == inex2 && mpfr_equal_p (x, b[i]));
+      inex1 = mpfr_sub (x, y, x, MPFR_RNDZ);
+      inex2 = mpfr_sub (b[i], b[i-1], b[i], MPFR_RNDZ);
+      MPFR_ASSERTN (inex1 == inex2 && mpfr_equal_p (x, b[i]));
+      inex1 = mpfr_exp (x, x, MPFR_RNDU);
+      inex2 = mpfr_exp (b[i], b[i], MPFR_RNDU);
+      MPFR_ASSERTN (inex1 == inex2 && mpfr_equal_p (x, b[i]));
+      inex1 = mpfr_div (x, x, y, MPFR_RNDN);
+      inex2 = mpfr_div (b[i], b[i], b[i-1], MPFR_RNDN);
+      MPFR_ASSERTN (inex1 == inex2 && mpfr_equal_p (x, b[i]));
+      inex1 = mpfr_sqrt (c, x, MPFR_RNDA);
+      inex2 = mpfr_sqrt (b[i], b[i], MPFR_RNDA);
+      MPFR_ASSERTN (inex1 == inex2 && mpfr_equal_p (c, b[i]));
+      MPFR_ASSERTN (mpfr_check (x));
+    }
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_clear (mpfr_small_ptr (&a[i]));
+      mpfr_clear (b[i]);
+    }
+  mpfr_clear (c);
+  tests_free (a, N * sizeof (mpfr_small_t));
+}
+
+/* Check the functions that may change the size of the significand. */
+static void
+check_prec (void)
+{
+  mpfr_small_t x;
+  mpfr_t y;
+  mpfr_prec_t p = MPFR_SMALL_PREC_MAX;
+
+  mpfr_init2 (y, 2 * p);
+
+  mpfr_small_init2 (x, 17);
+  mpfr_set_prec (mpfr_small_ptr (x), p);
+  MPFR_ASSERTN (IS_EMBEDDED (x));
+  mpfr_set_prec (mpfr_small_ptr (x), p + 1);
+  MPFR_ASSERTN (! IS_EMBEDDED (x));
+  mpfr_set_prec (mpfr_small_ptr (x), 17);
+  mpfr_clear (mpfr_small_ptr (x));
+
+  mpfr_small_init2 (x, p);
+  mpfr_const_pi (mpfr_small_ptr (x), MPFR_RNDN);
+  mpfr_prec_round (mpfr_small_ptr (x), 2 * p, MPFR_RNDN);
+  MPFR_ASSERTN (! IS_EMBEDDED (x));
+  mpfr_set_prec (y, p);
+  mpfr_const_pi (y, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_equal_p (mpfr_small_ptr (x), y));
+  mpfr_clear (mpfr_small_ptr (x));
+
+  mpfr_small_init2 (x, 2 * p);
+  MPFR_ASSERTN (! IS_EMBEDDED (x));
+  mpfr_clear (mpfr_small_ptr (x));
+
+  mpfr_clear (y);
+}
+
+/* Check mpfr_swap between a mpfr_small_t and an ordinary number of
+   precision q. */
+static void
+check_swap1 (mpfr_prec_t q, int reverse)
+{
+  mpfr_small_t x;
+  mpfr_t y, x0, y0;
+  mpfr_prec_t p = MPFR_SMALL_PREC_MAX - 1;
+
+  mpfr_small_init2 (x, p);
+  mpfr_init2 (y, 1);
+  mpfr_set_prec (y, q);  /* y has q bits allocated */
+  mpfr_init2 (x0, p);
+  mpfr_init2 (y0, q);
+  mpfr_urandomb (x0, RANDS);
+  mpfr_urandomb (y0, RANDS);
+  mpfr_set (mpfr_small_ptr (x), x0, MPFR_RNDN);
+  mpfr_set (y, y0, MPFR_RNDN);
+
+  if (reverse)
+    mpfr_swap (y, mpfr_small_ptr (x));
+  else
+    mpfr_swap (mpfr_small_ptr (x), y);
+  MPFR_ASSERTN (mpfr_get_prec (mpfr_small_ptr (x)) == q);
+  MPFR_ASSERTN (mpfr_get_prec (y) == p);
+  MPFR_ASSERTN (mpfr_equal_p (mpfr_small_ptr (x), y0));
+  MPFR_ASSERTN (mpfr_equal_p (y, x0));
+  MPFR_ASSERTN (IS_EMBEDDED (x) == (q <= MPFR_SMALL_PREC_MAX));
+  MPFR_ASSERTN (mpfr_check (mpfr_small_ptr (x)) && mpfr_check (y));
+
+  mpfr_clear (y);
+  mpfr_clear (mpfr_small_ptr (x));
+  mpfr_clear (x0);
+  mpfr_clear (y0);
+}
+
+static void
+check_swap (void)
+{
+  mpfr_small_t x, y;
+  int reverse;
+
+  for (reverse = 0; reverse <= 1; reverse++)
+    {
+      check_swap1 (1, reverse);
+      check_swap1 (MPFR_SMALL_PREC_MAX, reverse);
+      check_swap1 (10 * MPFR_SMALL_PREC_MAX, reverse);
+    }
+
+  mpfr_small_init2 (x, 10);
+  mpfr_small_init2 (y, 20);
+  mpfr_set_ui (mpfr_small_ptr (x), 1, MPFR_RNDN);
+  mpfr_set_ui (mpfr_small_ptr (y), 2, MPFR_RNDN);
+  mpfr_swap (mpfr_small_ptr (x), mpfr_small_ptr (y));
+  mpfr_swap (mpfr_small_ptr (x), mpfr_small_ptr (x));
+  MPFR_ASSERTN (IS_EMBEDDED (x) && IS_EMBEDDED (y));
+  MPFR_ASSERTN (mpfr_get_prec (mpfr_small_ptr (x)) == 20);
+  MPFR_ASSERTN (mpfr_cmp_ui (mpfr_small_ptr (x), 2) == 0);
+  MPFR_ASSERTN (mpfr_get_prec (mpfr_small_ptr (y)) == 10);
+  MPFR_ASSERTN (mpfr_cmp_ui (mpfr_small_ptr (y), 1) == 0);
+  mpfr_clear (mpfr_small_ptr (x));
+  mpfr_clear (mpfr_small_ptr (y));
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_array (1);
+  check_array (53);
+  check_array (MPFR_SMALL_PREC_MAX);
+  check_array (MPFR_SMALL_PREC_MAX + 1);
+  check_prec ();
+  check_swap ();
+
+  tests_end_mpfr ();
+  return 0;
+}
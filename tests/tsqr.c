@@ -339,6 +339,42 @@ coverage (mpfr_prec_t pmax)
     }
 }
 
+/* Check the squares of numbers having trailing zero limbs, which are
+   skipped: the results must be the same as with the same values in a
+   small precision. */
+static void
+check_sparse (void)
+{
+  mpfr_t x, x1, a1, a2;
+  int i, r, inex1, inex2;
+
+  mpfr_inits2 (1000, x1, a1, a2, (mpfr_ptr) 0);
+  for (i = 0; i < 200; i++)
+    {
+      mpfr_init2 (x, 1 + randlimb () % 200);
+      mpfr_set_prec (x1, 4 * mpfr_get_prec (x) + randlimb () % 3000);
+      mpfr_set_prec (a1, 1 + randlimb () % 3000);
+      mpfr_set_prec (a2, mpfr_get_prec (a1));
+      mpfr_urandomb (x, RANDS);
+      mpfr_set (x1, x, MPFR_RNDN);  /* exact */
+      RND_LOOP (r)
+        {
+          inex1 = mpfr_sqr (a1, x1, (mpfr_rnd_t) r);
+          inex2 = mpfr_sqr (a2, x, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              printf ("x1 = ");
+              mpfr_dump (x1);
+              exit (1);
+            }
+        }
+      mpfr_clear (x);
+    }
+  mpfr_clears (x1, a1, a2, (mpfr_ptr) 0);
+}
+
 int
 main (void)
 {
@@ -350,6 +386,7 @@ main (void)
   check_mpn_sqr ();
   check_special ();
   test_underflow ();
+  check_sparse ();
 
   for (p = MPFR_PREC_MIN; p < 200; p++)
     check_random (p);
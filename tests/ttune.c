@@ -0,0 +1,272 @@
+/* Test file for mpfr_tune_get, mpfr_tune_set, mpfr_tune_reset,
+   mpfr_tune_load, mpfr_tune_save and mpfr_tune_run.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define FILE_NAME "ttune.dat"
+
+static long defaults[MPFR_TUNE_MULHIGH_TAB];
+
+static void
+check_get_set (void)
+{
+  int p;
+  long size, i;
+
+  for (p = 0; p < MPFR_TUNE_MULHIGH_TAB; p++)
+    {
+      defaults[p] = mpfr_tune_get ((mpfr_tune_t) p, 0);
+      if (mpfr_tune_set ((mpfr_tune_t) p, 0, defaults[p]) != 0)
+        {
+          printf ("Error, mpfr_tune_set failed for p=%d v=%ld\n",
+                  p, defaults[p]);
+          exit (1);
+        }
+      if (p < MPFR_TUNE_AI_THRESHOLD1 &&
+          mpfr_tune_set ((mpfr_tune_t) p, 0, 0) == 0)
+        {
+          printf ("Error, mpfr_tune_set accepted 0 for p=%d\n", p);
+          exit (1);
+        }
+    }
+
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_MUL_THRESHOLD, 0) ==
+                MPFR_MUL_THRESHOLD);
+  MPFR_ASSERTN (mpfr_tune_set (MPFR_TUNE_MUL_THRESHOLD, 0, 17) == 0);
+  MPFR_ASSERTN (MPFR_MUL_THRESHOLD == 17);
+  MPFR_ASSERTN (mpfr_tune_set (MPFR_TUNE_MAX, 0, 17) != 0);
+
+  for (p = MPFR_TUNE_MULHIGH_TAB; p < MPFR_TUNE_MAX; p++)
+    {
+      size = mpfr_tune_get ((mpfr_tune_t) p, -1);
+      MPFR_ASSERTN (size >= 8);
+      MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, size, 0) != 0);
+      MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, -2, 0) != 0);
+      /* k = 1 is never a valid value for n >= 2 */
+      MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, 7, 1) != 0);
+      MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, 7, 7) != 0);
+      for (i = 0; i < size; i++)
+        MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, i,
+                                     mpfr_tune_get ((mpfr_tune_t) p, i))
+                      == 0);
+    }
+
+  mpfr_tune_reset ();
+  for (p = 0; p < MPFR_TUNE_MULHIGH_TAB; p++)
+    MPFR_ASSERTN (mpfr_tune_get ((mpfr_tune_t) p, 0) == defaults[p]);
+}
+
+/* The thresholds must not change the results. */
+static void
+check_results (void)
+{
+  mpfr_t x, y, z1, z2, z3, z4;
+  mpfr_prec_t prec;
+  mpfr_rnd_t rnd;
+  long size, i;
+  int n, inex1, inex2, inex3, inex4, p;
+
+  mpfr_inits2 (2000, x, y, z1, z2, z3, z4, (mpfr_ptr) 0);
+  for (n = 0; n < 100; n++)
+    {
+      prec = MPFR_PREC_MIN + (randlimb () % 1500);
+      mpfr_set_prec (x, prec);
+      mpfr_set_prec (y, prec);
+      mpfr_set_prec (z1, prec);
+      mpfr_set_prec (z2, prec);
+      mpfr_set_prec (z3, prec);
+      mpfr_set_prec (z4, prec);
+      mpfr_urandomb (x, RANDS);
+      mpfr_urandomb (y, RANDS);
+      rnd = RND_RAND_NO_RNDF ();
+
+      mpfr_tune_reset ();
+      inex1 = mpfr_mul (z1, x, y, rnd);
+      inex2 = mpfr_sqr (z2, x, rnd);
+      inex3 = mpfr_div (z3, x, y, rnd);
+
+      /* Use the short product and short division as much as possible. */
+      for (p = 0; p < MPFR_TUNE_AI_THRESHOLD1; p++)
+        MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, 0, 1) == 0);
+      for (p = MPFR_TUNE_MULHIGH_TAB; p < MPFR_TUNE_MAX; p++)
+        {
+          size = mpfr_tune_get ((mpfr_tune_t) p, -1);
+          for (i = 0; i < size; i++)
+            if (mpfr_tune_set ((mpfr_tune_t) p, i, (i + 4) / 2) != 0)
+              MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, i, 0) == 0);
+        }
+
+      if (! SAME_SIGN (mpfr_mul (z4, x, y, rnd), inex1) ||
+          ! mpfr_equal_p (z4, z1))
+        {
+          printf ("Error in check_results for mpfr_mul, prec=%ld rnd=%s\n",
+                  (long) prec, mpfr_print_rnd_mode (rnd));
+          exit (1);
+        }
+      if (! SAME_SIGN (mpfr_sqr (z1, x, rnd), inex2) ||
+          ! mpfr_equal_p (z1, z2))
+        {
+          printf ("Error in check_results for mpfr_sqr, prec=%ld rnd=%s\n",
+                  (long) prec, mpfr_print_rnd_mode (rnd));
+          exit (1);
+        }
+      if (! SAME_SIGN (mpfr_div (z1, x, y, rnd), inex3) ||
+          ! mpfr_equal_p (z1, z3))
+        {
+          printf ("Error in check_results for mpfr_div, prec=%ld rnd=%s\n",
+                  (long) prec, mpfr_print_rnd_mode (rnd));
+          exit (1);
+        }
+      mpfr_tune_reset ();
+      inex4 = mpfr_exp (z4, x, rnd);
+      MPFR_ASSERTN (mpfr_tune_set (MPFR_TUNE_EXP_THRESHOLD, 0, 1) == 0);
+      if (! SAME_SIGN (mpfr_exp (z1, x, rnd), inex4) ||
+          ! mpfr_equal_p (z1, z4))
+        {
+          printf ("Error in check_results for mpfr_exp, prec=%ld rnd=%s\n",
+                  (long) prec, mpfr_print_rnd_mode (rnd));
+          exit (1);
+        }
+    }
+  mpfr_clears (x, y, z1, z2, z3, z4, (mpfr_ptr) 0);
+  mpfr_tune_reset ();
+}
+
+static void
+check_load_save (void)
+{
+  FILE *f;
+  long size, k;
+
+  /* with MPFR_TUNE_FILE unset, mpfr_tune_load (NULL) does nothing */
+  if (getenv ("MPFR_TUNE_FILE") == NULL)
+    MPFR_ASSERTN (mpfr_tune_load (NULL) == 0);
+
+  size = mpfr_tune_get (MPFR_TUNE_DIVHIGH_TAB, -1);
+  k = mpfr_tune_get (MPFR_TUNE_DIVHIGH_TAB, size - 1) == 0 ? (size + 3) / 2
+    : 0;
+  MPFR_ASSERTN (mpfr_tune_set (MPFR_TUNE_MUL_THRESHOLD, 0, 5) == 0);
+  MPFR_ASSERTN (mpfr_tune_set (MPFR_TUNE_AI_THRESHOLD2, 0, -3) == 0);
+  MPFR_ASSERTN (mpfr_tune_set (MPFR_TUNE_DIVHIGH_TAB, size - 1, k) == 0);
+  if (mpfr_tune_save (FILE_NAME) != 0)
+    {
+      printf ("Error, mpfr_tune_save failed\n");
+      exit (1);
+    }
+
+  mpfr_tune_reset ();
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_MUL_THRESHOLD, 0) ==
+                defaults[MPFR_TUNE_MUL_THRESHOLD]);
+  if (mpfr_tune_load (FILE_NAME) != 0)
+    {
+      printf ("Error, mpfr_tune_load failed\n");
+      exit (1);
+    }
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_MUL_THRESHOLD, 0) == 5);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_AI_THRESHOLD2, 0) == -3);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_DIVHIGH_TAB, size - 1) == k);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_SQR_THRESHOLD, 0) ==
+                defaults[MPFR_TUNE_SQR_THRESHOLD]);
+
+  /* partial file with a comment; an invalid value must change nothing */
+  f = fopen (FILE_NAME, "w");
+  MPFR_ASSERTN (f != NULL);
+  fprintf (f, "# test\nsqr_threshold 7\nmulhigh_tab -1 -1\n");
+  MPFR_ASSERTN (fclose (f) == 0);
+  MPFR_ASSERTN (mpfr_tune_load (FILE_NAME) == 0);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_SQR_THRESHOLD, 0) == 7);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_MUL_THRESHOLD, 0) == 5);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_MULHIGH_TAB, 1) == -1);
+
+  f = fopen (FILE_NAME, "w");
+  MPFR_ASSERTN (f != NULL);
+  fprintf (f, "sqr_threshold 9\nmul_threshold 0\n");
+  MPFR_ASSERTN (fclose (f) == 0);
+  MPFR_ASSERTN (mpfr_tune_load (FILE_NAME) != 0);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_SQR_THRESHOLD, 0) == 7);
+
+  f = fopen (FILE_NAME, "w");
+  MPFR_ASSERTN (f != NULL);
+  fprintf (f, "sqr_threshold 9\nfoo_threshold 1\n");
+  MPFR_ASSERTN (fclose (f) == 0);
+  MPFR_ASSERTN (mpfr_tune_load (FILE_NAME) != 0);
+  MPFR_ASSERTN (mpfr_tune_get (MPFR_TUNE_SQR_THRESHOLD, 0) == 7);
+
+  remove (FILE_NAME);
+  MPFR_ASSERTN (mpfr_tune_load (FILE_NAME) != 0);
+  mpfr_tune_reset ();
+}
+
+/* mpfr_tune_run with a small budget: the parameters must remain valid,
+   the results and the flags must not change. */
+static void
+check_run (void)
+{
+  mpfr_t x, y, z1, z2;
+  long size, i;
+  int p, inex1, inex2;
+
+  mpfr_inits2 (1000, x, y, z1, z2, (mpfr_ptr) 0);
+  mpfr_urandomb (x, RANDS);
+  mpfr_urandomb (y, RANDS);
+  inex1 = mpfr_mul (z1, x, y, MPFR_RNDN);
+
+  mpfr_clear_flags ();
+  mpfr_set_divby0 ();
+  (void) mpfr_tune_run (200);
+  MPFR_ASSERTN (__gmpfr_flags == MPFR_FLAGS_DIVBY0);
+
+  for (p = 0; p < MPFR_TUNE_MULHIGH_TAB; p++)
+    MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, 0,
+                                 mpfr_tune_get ((mpfr_tune_t) p, 0)) == 0);
+  for (p = MPFR_TUNE_MULHIGH_TAB; p < MPFR_TUNE_MAX; p++)
+    {
+      size = mpfr_tune_get ((mpfr_tune_t) p, -1);
+      for (i = 0; i < size; i++)
+        MPFR_ASSERTN (mpfr_tune_set ((mpfr_tune_t) p, i,
+                                     mpfr_tune_get ((mpfr_tune_t) p, i))
+                      == 0);
+    }
+
+  inex2 = mpfr_mul (z2, x, y, MPFR_RNDN);
+  if (! SAME_SIGN (inex1, inex2) || ! mpfr_equal_p (z1, z2))
+    {
+      printf ("Error in check_run for mpfr_mul\n");
+      exit (1);
+    }
+  mpfr_clears (x, y, z1, z2, (mpfr_ptr) 0);
+  mpfr_tune_reset ();
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_get_set ();
+  check_results ();
+  check_load_save ();
+  check_run ();
+
+  tests_end_mpfr ();
+  return 0;
+}
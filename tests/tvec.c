@@ -0,0 +1,228 @@
+/* tvec -- test file for mpfr_add_vec, mpfr_mul_vec and mpfr_fma_vec
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define N 64
+
+static mpfr_t r1[N], r2[N], b[N], c[N], d[N];
+static mpfr_ptr r1p[N], r2p[N], bp[N], cp[N], dp[N];
+
+/* Set x to a random value: mostly regular numbers with both signs and
+   random exponents (including near the extremes of the exponent range,
+   to get overflows and underflows), sometimes a singular value. */
+static void
+random_value (mpfr_ptr x)
+{
+  unsigned long k = randlimb () % 32;
+
+  if (k == 0)
+    mpfr_set_nan (x);
+  else if (k == 1)
+    mpfr_set_inf (x, RAND_SIGN ());
+  else if (k == 2)
+    mpfr_set_zero (x, RAND_SIGN ());
+  else
+    {
+      mpfr_urandomb (x, RANDS);
+      if (MPFR_IS_ZERO (x))
+        return;
+      if (k == 3)
+        mpfr_set_exp (x, mpfr_get_emax ());
+      else if (k == 4)
+        mpfr_set_exp (x, mpfr_get_emin ());
+      else
+        mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % 16) - 8);
+      if (RAND_BOOL ())
+        mpfr_neg (x, x, MPFR_RNDN);
+    }
+}
+
+static void
+check_vec (mpfr_prec_t p, int op)
+{
+  int t1[N], t2[N];
+  int i, rnd, res1, res2;
+  mpfr_flags_t flags1, flags2;
+
+  for (i = 0; i < N; i++)
+    {
+      /* use another precision for a few elements */
+      mpfr_prec_t q = (randlimb () % 16 == 0) ? p + 1 : p;
+
+      mpfr_set_prec (r1[i], q);
+      mpfr_set_prec (r2[i], q);
+      mpfr_set_prec (b[i], p);
+      mpfr_set_prec (c[i], p);
+      mpfr_set_prec (d[i], p);
+      random_value (b[i]);
+      random_value (c[i]);
+      random_value (d[i]);
+      /* make the additions with opposite signs more likely to cancel */
+      if (randlimb () % 4 == 0 && MPFR_IS_PURE_FP (b[i]))
+        mpfr_neg (c[i], b[i], MPFR_RNDN);
+    }
+  /* in order to test the choice of the kernel, a[0] must have the
+     precision p */
+  mpfr_set_prec (r1[0], p);
+  mpfr_set_prec (r2[0], p);
+
+  RND_LOOP (rnd)
+    {
+      res2 = 0;
+      mpfr_clear_flags ();
+      for (i = 0; i < N; i++)
+        {
+          t2[i] = op == 0 ? mpfr_add (r2[i], b[i], c[i], (mpfr_rnd_t) rnd)
+            : op == 1 ? mpfr_mul (r2[i], b[i], c[i], (mpfr_rnd_t) rnd)
+            : mpfr_fma (r2[i], b[i], c[i], d[i], (mpfr_rnd_t) rnd);
+          res2 |= t2[i];
+        }
+      flags2 = __gmpfr_flags;
+
+      mpfr_clear_flags ();
+      res1 = op == 0 ?
+        mpfr_add_vec (r1p, bp, cp, N, (mpfr_rnd_t) rnd, t1)
+        : op == 1 ? mpfr_mul_vec (r1p, bp, cp, N, (mpfr_rnd_t) rnd, t1)
+        : mpfr_fma_vec (r1p, bp, cp, dp, N, (mpfr_rnd_t) rnd, t1);
+      flags1 = __gmpfr_flags;
+
+      if ((res1 != 0) != (res2 != 0) || flags1 != flags2)
+        {
+          printf ("Error in %s for p = %lu, %s\n",
+                  op == 0 ? "mpfr_add_vec" : op == 1 ? "mpfr_mul_vec"
+                  : "mpfr_fma_vec", (unsigned long) p,
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          printf ("got res = %d, flags =", res1);
+          flags_out (flags1);
+          printf ("expected res = %d, flags =", res2);
+          flags_out (flags2);
+          exit (1);
+        }
+      for (i = 0; i < N; i++)
+        if (! SAME_VAL (r1[i], r2[i]) || VSIGN (t1[i]) != VSIGN (t2[i]))
+          {
+            printf ("Error in %s for p = %lu, %s, i = %d\n",
+                    op == 0 ? "mpfr_add_vec" : op == 1 ? "mpfr_mul_vec"
+                    : "mpfr_fma_vec", (unsigned long) p,
+                    mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), i);
+            printf ("b = ");
+            mpfr_dump (b[i]);
+            printf ("c = ");
+            mpfr_dump (c[i]);
+            if (op == 2)
+              {
+                printf ("d = ");
+                mpfr_dump (d[i]);
+              }
+            printf ("got      ");
+            mpfr_dump (r1[i]);
+            printf ("expected ");
+            mpfr_dump (r2[i]);
+            printf ("got t = %d, expected t = %d\n", t1[i], t2[i]);
+            exit (1);
+          }
+    }
+
+  /* t can be a null pointer */
+  res1 = op == 0 ? mpfr_add_vec (r1p, bp, cp, N, MPFR_RNDN, NULL)
+    : op == 1 ? mpfr_mul_vec (r1p, bp, cp, N, MPFR_RNDN, NULL)
+    : mpfr_fma_vec (r1p, bp, cp, dp, N, MPFR_RNDN, NULL);
+  res2 = op == 0 ? mpfr_add_vec (r2p, bp, cp, N, MPFR_RNDN, t2)
+    : op == 1 ? mpfr_mul_vec (r2p, bp, cp, N, MPFR_RNDN, t2)
+    : mpfr_fma_vec (r2p, bp, cp, dp, N, MPFR_RNDN, t2);
+  MPFR_ASSERTN ((res1 != 0) == (res2 != 0));
+}
+
+/* Check the in-place operations a[i] <- a[i] op a[i]. */
+static void
+check_inplace (void)
+{
+  mpfr_prec_t p;
+  int i, t[N];
+
+  for (p = MPFR_PREC_MIN; p <= 3 * GMP_NUMB_BITS + 1; p++)
+    {
+      for (i = 0; i < N; i++)
+        {
+          mpfr_set_prec (r1[i], p);
+          mpfr_set_prec (r2[i], p);
+          random_value (r1[i]);
+          mpfr_set (r2[i], r1[i], MPFR_RNDN);
+        }
+      mpfr_add_vec (r1p, r1p, r1p, N, MPFR_RNDN, t);
+      mpfr_mul_vec (r1p, r1p, r1p, N, MPFR_RNDZ, t);
+      for (i = 0; i < N; i++)
+        {
+          mpfr_add (r2[i], r2[i], r2[i], MPFR_RNDN);
+          mpfr_mul (r2[i], r2[i], r2[i], MPFR_RNDZ);
+          if (! SAME_VAL (r1[i], r2[i]))
+            {
+              printf ("Error in check_inplace for p = %lu, i = %d\n",
+                      (unsigned long) p, i);
+              printf ("got      ");
+              mpfr_dump (r1[i]);
+              printf ("expected ");
+              mpfr_dump (r2[i]);
+              exit (1);
+            }
+        }
+    }
+}
+
+int
+main (void)
+{
+  mpfr_prec_t p;
+  int i, op;
+
+  tests_start_mpfr ();
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_inits2 (MPFR_PREC_MIN, r1[i], r2[i], b[i], c[i], d[i],
+                   (mpfr_ptr) 0);
+      r1p[i] = r1[i];
+      r2p[i] = r2[i];
+      bp[i] = b[i];
+      cp[i] = c[i];
+      dp[i] = d[i];
+    }
+
+  for (op = 0; op < 3; op++)
+    {
+      /* test n = 0 */
+      MPFR_ASSERTN ((op == 0 ? mpfr_add_vec (r1p, bp, cp, 0, MPFR_RNDN, NULL)
+                     : op == 1 ? mpfr_mul_vec (r1p, bp, cp, 0, MPFR_RNDN, NULL)
+                     : mpfr_fma_vec (r1p, bp, cp, dp, 0, MPFR_RNDN, NULL))
+                    == 0);
+      for (p = MPFR_PREC_MIN; p <= 3 * GMP_NUMB_BITS + 1; p++)
+        check_vec (p, op);
+      check_vec (10 * GMP_NUMB_BITS, op);
+    }
+  check_inplace ();
+
+  for (i = 0; i < N; i++)
+    mpfr_clears (r1[i], r2[i], b[i], c[i], d[i], (mpfr_ptr) 0);
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,256 @@
+/* tvec_init -- test file for the mpfr_vec_t functions
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+/* 100 is not a multiple of the size of the chunks in vec.c */
+#define N 100
+
+static void
+check_init (void)
+{
+  mpfr_vec_t v;
+  mpfr_t x;
+  unsigned long i;
+
+  mpfr_vec_init2 (v, N, 17);
+  MPFR_ASSERTN (mpfr_vec_size (v) == N);
+  MPFR_ASSERTN (mpfr_vec_get_prec (v) == 17);
+  mpfr_init2 (x, 17);
+  for (i = 0; i < N; i++)
+    {
+      mpfr_vec_get (x, v, i, MPFR_RNDN);
+      MPFR_ASSERTN (mpfr_nan_p (x));
+    }
+  mpfr_clear (x);
+  mpfr_vec_clear (v);
+  MPFR_ASSERTN (mpfr_vec_size (v) == 0);
+
+  mpfr_vec_init2 (v, 0, MPFR_PREC_MIN);
+  MPFR_ASSERTN (mpfr_vec_size (v) == 0);
+  mpfr_vec_clear (v);
+}
+
+/* Check mpfr_vec_set, mpfr_vec_get and the views with the custom
+   interface. */
+static void
+check_view (mpfr_prec_t p)
+{
+  mpfr_vec_t v;
+  mpfr_t x, y, w;
+  unsigned long i;
+  int inex1, inex2;
+
+  mpfr_vec_init2 (v, N, p);
+  mpfr_inits2 (p + 10, x, y, (mpfr_ptr) 0);
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_urandomb (x, RANDS);
+      mpfr_mul_si (x, x, (long) i - N / 2, MPFR_RNDN);
+      inex1 = mpfr_vec_set (v, i, x, MPFR_RNDU);
+      mpfr_set_prec (y, p);
+      inex2 = mpfr_set (y, x, MPFR_RNDU);
+      mpfr_vec_view (w, v, i);
+      if (! SAME_VAL (w, y) || VSIGN (inex1) != VSIGN (inex2))
+        {
+          printf ("Error in mpfr_vec_set for p = %lu, i = %lu\n",
+                  (unsigned long) p, i);
+          printf ("expected ");
+          mpfr_dump (y);
+          printf ("got      ");
+          mpfr_dump (w);
+          exit (1);
+        }
+      MPFR_ASSERTN (mpfr_custom_get_significand (w) ==
+                    (void *) (v->_mpfr_vec_d +
+                              i * (mpfr_custom_get_size (p)
+                                   / sizeof (mp_limb_t))));
+
+      /* modify the element through the view */
+      mpfr_neg (w, w, MPFR_RNDN);
+      mpfr_vec_update (v, i, w);
+      mpfr_set_prec (y, p + 10);
+      mpfr_vec_get (y, v, i, MPFR_RNDN);
+      mpfr_vec_view (w, v, i);
+      MPFR_ASSERTN (SAME_VAL (w, y));
+      MPFR_ASSERTN (mpfr_custom_get_kind (w) ==
+                    (mpfr_zero_p (y) ? MPFR_ZERO_KIND : MPFR_REGULAR_KIND)
+                    * (mpfr_signbit (y) ? -1 : 1));
+    }
+
+  /* special values */
+  mpfr_set_inf (x, -1);
+  mpfr_vec_set (v, 0, x, MPFR_RNDN);
+  mpfr_vec_view (w, v, 0);
+  MPFR_ASSERTN (mpfr_custom_get_kind (w) == - (int) MPFR_INF_KIND);
+  mpfr_set_nan (x);
+  mpfr_vec_set (v, N - 1, x, MPFR_RNDN);
+  mpfr_vec_view (w, v, N - 1);
+  MPFR_ASSERTN (mpfr_custom_get_kind (w) == MPFR_NAN_KIND);
+
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+  mpfr_vec_clear (v);
+}
+
+/* Check mpfr_vec_add, mpfr_vec_mul and mpfr_vec_fma against the scalar
+   functions, including the case where the output is one of the inputs. */
+static void
+check_ops (mpfr_prec_t p)
+{
+  mpfr_vec_t r, x, y, z;
+  mpfr_t a, b, c, d, e;
+  int t[N], inex, op, rnd;
+  unsigned long i;
+  mpfr_flags_t flags1, flags2;
+
+  mpfr_vec_init2 (r, N, p);
+  mpfr_vec_init2 (x, N, p);
+  mpfr_vec_init2 (y, N, p);
+  mpfr_vec_init2 (z, N, p + 1);
+  mpfr_inits2 (p, a, b, c, e, (mpfr_ptr) 0);
+  mpfr_init2 (d, p + 1);
+
+  for (op = 0; op < 3; op++)
+    RND_LOOP (rnd)
+      {
+        int in_place = rnd & 1;
+
+        for (i = 0; i < N; i++)
+          {
+            mpfr_urandomb (b, RANDS);
+            mpfr_mul_2si (b, b, (long) (randlimb () % 200) - 100, MPFR_RNDN);
+            if (RAND_BOOL ())
+              mpfr_neg (b, b, MPFR_RNDN);
+            mpfr_urandomb (c, RANDS);
+            if (i % 17 == 0)
+              mpfr_set_zero (c, -1);
+            /* special values, overflow and underflow */
+            if (i % 19 == 0)
+              mpfr_set_inf (b, RAND_SIGN ());
+            if (i % 23 == 0)
+              mpfr_set_nan (c);
+            if (i % 13 == 0 && mpfr_regular_p (b))
+              mpfr_set_exp (b, mpfr_get_emax ());
+            if (i % 11 == 0 && mpfr_regular_p (b))
+              mpfr_set_exp (b, mpfr_get_emin ());
+            if (i % 7 == 0 && mpfr_regular_p (c))
+              mpfr_set_exp (c, i % 2 ? mpfr_get_emax () : mpfr_get_emin ());
+            mpfr_urandomb (d, RANDS);
+            mpfr_vec_set (x, i, b, MPFR_RNDN);
+            mpfr_vec_set (y, i, c, MPFR_RNDN);
+            mpfr_vec_set (z, i, d, MPFR_RNDN);
+          }
+        if (in_place)
+          for (i = 0; i < N; i++)
+            {
+              mpfr_vec_get (a, x, i, MPFR_RNDN);
+              mpfr_vec_set (r, i, a, MPFR_RNDN);
+            }
+
+        mpfr_clear_flags ();
+        if (op == 0)
+          mpfr_vec_add (r, in_place ? r : x, y, (mpfr_rnd_t) rnd, t);
+        else if (op == 1)
+          mpfr_vec_mul (r, in_place ? r : x, y, (mpfr_rnd_t) rnd, t);
+        else
+          mpfr_vec_fma (r, in_place ? r : x, y, z, (mpfr_rnd_t) rnd, t);
+        flags1 = __gmpfr_flags;
+        mpfr_clear_flags ();
+
+        for (i = 0; i < N; i++)
+          {
+            /* mpfr_vec_get is exact, but sets the NaN flag for NaN */
+            flags2 = __gmpfr_flags;
+            mpfr_vec_get (b, x, i, MPFR_RNDN);
+            mpfr_vec_get (c, y, i, MPFR_RNDN);
+            mpfr_vec_get (d, z, i, MPFR_RNDN);
+            __gmpfr_flags = flags2;
+            inex = op == 0 ? mpfr_add (e, b, c, (mpfr_rnd_t) rnd)
+              : op == 1 ? mpfr_mul (e, b, c, (mpfr_rnd_t) rnd)
+              : mpfr_fma (e, b, c, d, (mpfr_rnd_t) rnd);
+            flags2 = __gmpfr_flags;
+            mpfr_vec_get (a, r, i, MPFR_RNDN);
+            __gmpfr_flags = flags2;
+            if (! SAME_VAL (a, e) || VSIGN (inex) != VSIGN (t[i]))
+              {
+                printf ("Error in check_ops for op = %d, p = %lu, %s,"
+                        " i = %lu%s\n", op, (unsigned long) p,
+                        mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), i,
+                        in_place ? " (in place)" : "");
+                printf ("x = ");
+                mpfr_dump (b);
+                printf ("y = ");
+                mpfr_dump (c);
+                if (op == 2)
+                  {
+                    printf ("z = ");
+                    mpfr_dump (d);
+                  }
+                printf ("expected ");
+                mpfr_dump (e);
+                printf ("got      ");
+                mpfr_dump (a);
+                printf ("expected t = %d, got t = %d\n", inex, t[i]);
+                exit (1);
+              }
+          }
+        flags2 = __gmpfr_flags;
+        if (flags1 != flags2)
+          {
+            printf ("Error in check_ops for op = %d, p = %lu, %s%s\n",
+                    op, (unsigned long) p,
+                    mpfr_print_rnd_mode ((mpfr_rnd_t) rnd),
+                    in_place ? " (in place)" : "");
+            printf ("expected flags =");
+            flags_out (flags2);
+            printf ("got flags      =");
+            flags_out (flags1);
+            exit (1);
+          }
+      }
+
+  mpfr_clears (a, b, c, d, e, (mpfr_ptr) 0);
+  mpfr_vec_clear (r);
+  mpfr_vec_clear (x);
+  mpfr_vec_clear (y);
+  mpfr_vec_clear (z);
+}
+
+int
+main (void)
+{
+  mpfr_prec_t p;
+
+  tests_start_mpfr ();
+
+  check_init ();
+  for (p = MPFR_PREC_MIN; p <= 3 * GMP_NUMB_BITS + 1; p++)
+    {
+      check_view (p);
+      check_ops (p);
+    }
+  check_view (1000);
+  check_ops (1000);
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -330,6 +330,17 @@ main (void)
       err = 1;
     }
 
+  if (
+#ifdef MPFR_WANT_PARALLEL
+      !
+#endif
+      mpfr_buildopt_parallel_p ())
+    {
+      printf ("ERROR! mpfr_buildopt_parallel_p() and macros"
+              " do not match!\n");
+      err = 1;
+    }
+
 #ifdef MPFR_WANT_FLOAT128
 # define MPFR_F128 "yes (" MAKE_STR(mpfr_float128) ")"
 #else
@@ -359,8 +370,9 @@ main (void)
 # define LOCK_METHOD ""
 #endif
 
-  (printf) ("[tversion] Shared cache = %s\n",
-            mpfr_buildopt_sharedcache_p () ? "yes" LOCK_METHOD : "no");
+  (printf) ("[tversion] Shared cache = %s, parallel mode = %s\n",
+            mpfr_buildopt_sharedcache_p () ? "yes" LOCK_METHOD : "no",
+            mpfr_buildopt_parallel_p () ? "yes" : "no");
 
   (puts) ("[tversion] intmax_t = "
 #if defined(_MPFR_H_HAVE_INTMAX_T)
@@ -0,0 +1,185 @@
+/* callbench.c -- measure the per-call overhead of some functions at 53 bits
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* At small precision, the time of most functions is dominated by the
+   fixed cost of a call: the special cases, the save and restore of the
+   flags and of the exponent range (MPFR_SAVE_EXPO_MARK and
+   MPFR_SAVE_EXPO_FREE), which are thread-local variables in a thread-safe
+   build, and the final range check. This program gives the time of one
+   call in nanoseconds for some cheap functions; mpfr_mul does not change
+   the exponent range and serves as a reference.
+
+   Usage: callbench [precision] */
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_GETRUSAGE
+#include <sys/time.h>
+#include <sys/resource.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+#define NB_RAND_FLOAT 1000
+
+static mpfr_t x[NB_RAND_FLOAT], y[NB_RAND_FLOAT], z[NB_RAND_FLOAT];
+static double d[NB_RAND_FLOAT];
+
+static void
+call_mul (int i)
+{
+  mpfr_mul (z[i], x[i], y[i], MPFR_RNDN);
+}
+
+static void
+call_mul_ui (int i)
+{
+  mpfr_mul_ui (z[i], x[i], 17, MPFR_RNDN);
+}
+
+static void
+call_add_d (int i)
+{
+  mpfr_add_d (z[i], x[i], d[i], MPFR_RNDN);
+}
+
+static void
+call_set_d (int i)
+{
+  mpfr_set_d (z[i], d[i], MPFR_RNDN);
+}
+
+static void
+call_fma (int i)
+{
+  mpfr_fma (z[i], x[i], y[i], x[i], MPFR_RNDN);
+}
+
+static void
+call_hypot (int i)
+{
+  mpfr_hypot (z[i], x[i], y[i], MPFR_RNDN);
+}
+
+static void
+call_frac (int i)
+{
+  mpfr_frac (z[i], d[i] < 0.5 ? x[i] : y[i], MPFR_RNDN);
+}
+
+struct benchfunc
+{
+  const char *name;
+  void (*func) (int);
+};
+
+static const struct benchfunc arrayfunc[] = {
+  { "mul", call_mul },
+  { "mul_ui", call_mul_ui },
+  { "add_d", call_add_d },
+  { "set_d", call_set_d },
+  { "fma", call_fma },
+  { "hypot", call_hypot },
+  { "frac", call_frac }
+};
+
+/* get the time in microseconds */
+static unsigned long
+get_cputime (void)
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+
+  getrusage (RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec
+       + ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+#else
+  return (unsigned long) ((double) clock () / ((double) CLOCKS_PER_SEC / 1e6));
+#endif
+}
+
+/* return the time of niter calls of f, in microseconds */
+static unsigned long
+time_calls (void (*f) (int), unsigned long niter)
+{
+  unsigned long t0, i;
+  int k;
+
+  t0 = get_cputime ();
+  for (i = 0, k = 0; i < niter; i++)
+    {
+      f (k);
+      if (++k == NB_RAND_FLOAT)
+        k = 0;
+    }
+  return get_cputime () - t0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  gmp_randstate_t randstate;
+  mpfr_prec_t prec = 53;
+  unsigned long niter, ti;
+  int i;
+
+  if (argc > 1)
+    prec = atol (argv[1]);
+  if (prec < MPFR_PREC_MIN || prec > MPFR_PREC_MAX)
+    {
+      fprintf (stderr, "callbench: invalid precision\n");
+      exit (1);
+    }
+
+  gmp_randinit_default (randstate);
+  for (i = 0; i < NB_RAND_FLOAT; i++)
+    {
+      mpfr_init2 (x[i], prec);
+      mpfr_init2 (y[i], prec);
+      mpfr_init2 (z[i], prec);
+      mpfr_urandomb (x[i], randstate);
+      mpfr_urandomb (y[i], randstate);
+      mpfr_mul_2si (y[i], y[i], 4, MPFR_RNDN);
+      d[i] = mpfr_get_d (y[i], MPFR_RNDN) / 16.0;
+    }
+
+  printf ("MPFR : %s, precision %ld\n\n", mpfr_get_version (), (long) prec);
+  for (i = 0; i < (int) (sizeof (arrayfunc) / sizeof (arrayfunc[0])); i++)
+    {
+      /* double the number of calls until they take at least 0.5 s */
+      for (niter = 1024; (ti = time_calls (arrayfunc[i].func, niter)) < 500000;
+           niter *= 2)
+        ;
+      printf ("%8s : %8.2f ns per call\n", arrayfunc[i].name,
+              1000.0 * (double) ti / (double) niter);
+    }
+
+  for (i = 0; i < NB_RAND_FLOAT; i++)
+    {
+      mpfr_clear (x[i]);
+      mpfr_clear (y[i]);
+      mpfr_clear (z[i]);
+    }
+  gmp_randclear (randstate);
+  mpfr_free_cache ();
+  return 0;
+}